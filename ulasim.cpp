@@ -2,8 +2,34 @@
 #include <cstring>
 #include <cstdlib>
 #include <climits>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/resource.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <chrono>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 
+// Buyuyebilen dizi. Sinir kontrolu yalnizca hata ayiklama derlemesinde yapilir (-DNDEBUG ile
+// kapanir, her zaman kontrol isteyen at() kullanir). Buyumede elemanlar yeni bellege
+// placement-new ile tasinir (move), eski kopyalar yikilir.
 template <typename T>
 class VecArr {
 private:
@@ -12,42 +38,201 @@ private:
     int len;
 
     void resize(int yeniCap) {
-        T* newData = (T*) std::malloc(sizeof(T) * yeniCap);
+        T* newData = (T*) std::malloc(sizeof(T) * (yeniCap > 0 ? yeniCap : 1));
         for (int i = 0; i < len; ++i) {
-            newData[i] = data[i];
+            new (&newData[i]) T(std::move(data[i]));
+            data[i].~T();
         }
         std::free(data);
         data = newData;
         cap = yeniCap;
     }
 
+    void buyu() { resize(cap == 0 ? 4 : cap * 2); }
+
+    void temizle() {
+        for (int i = 0; i < len; ++i) data[i].~T();
+        if (data) std::free(data);
+        data = nullptr; cap = 0; len = 0;
+    }
+
+    static void sinirHatasi(int idx, int len) {
+        std::fprintf(stderr, "VecArr HATA: idx=%d, len=%d\n", idx, len);
+        std::exit(1);
+    }
+
 public:
     VecArr(): data(nullptr), cap(0), len(0) {}
-    ~VecArr() { if (data) std::free(data); }
+    VecArr(const VecArr& o): data(nullptr), cap(0), len(0) {
+        if (o.len > 0) resize(o.len);
+        for (int i = 0; i < o.len; ++i) new (&data[i]) T(o.data[i]);
+        len = o.len;
+    }
+    VecArr(VecArr&& o): data(o.data), cap(o.cap), len(o.len) {
+        o.data = nullptr; o.cap = 0; o.len = 0;
+    }
+    VecArr& operator=(const VecArr& o) {
+        if (this == &o) return *this;
+        temizle();
+        if (o.len > 0) resize(o.len);
+        for (int i = 0; i < o.len; ++i) new (&data[i]) T(o.data[i]);
+        len = o.len;
+        return *this;
+    }
+    VecArr& operator=(VecArr&& o) {
+        if (this == &o) return *this;
+        temizle();
+        data = o.data; cap = o.cap; len = o.len;
+        o.data = nullptr; o.cap = 0; o.len = 0;
+        return *this;
+    }
+    ~VecArr() { temizle(); }
 
     void pushLast(const T& val) {
         if (len + 1 > cap) {
-            int newCap = (cap == 0 ? 4 : cap * 2);
-            resize(newCap);
+            T kopya(val);            // val dizinin kendi elemani olabilir, buyumeden once kopyala
+            buyu();
+            new (&data[len]) T(std::move(kopya));
+        } else {
+            new (&data[len]) T(val);
+        }
+        len++;
+    }
+
+    void pushLast(T&& val) {
+        if (len + 1 > cap) {
+            T gecici(std::move(val));
+            buyu();
+            new (&data[len]) T(std::move(gecici));
+        } else {
+            new (&data[len]) T(std::move(val));
         }
-        data[len++] = val;
+        len++;
     }
 
     void popLast() {
-        if (len > 0) --len;
+        if (len > 0) data[--len].~T();
+    }
+
+    // idx'teki elemani cikarir, sonrakileri bir sola tasir (sira korunur)
+    void removeAt(int idx) {
+        if (idx < 0 || idx >= len) return;
+        for (int i = idx; i + 1 < len; ++i) data[i] = std::move(data[i + 1]);
+        popLast();
+    }
+
+    void clear() {
+        for (int i = 0; i < len; ++i) data[i].~T();
+        len = 0;
+    }
+
+    // en az n eleman icin yer ayirir, boyutu degistirmez
+    void reserve(int n) {
+        if (n > cap) resize(n);
+    }
+
+    // kapasiteyi eleman sayisina indirir
+    void shrink_to_fit() {
+        if (len == 0) { temizle(); return; }
+        if (cap > len) resize(len);
     }
 
     T& operator[](int idx) {
-        if (idx < 0 || idx >= len) {
-            std::fprintf(stderr, "VecArr HATA: idx=%d, len=%d\n", idx, len);
-            std::exit(1);
-        }
+#ifndef NDEBUG
+        if (idx < 0 || idx >= len) sinirHatasi(idx, len);
+#endif
+        return data[idx];
+    }
+
+    const T& operator[](int idx) const {
+#ifndef NDEBUG
+        if (idx < 0 || idx >= len) sinirHatasi(idx, len);
+#endif
+        return data[idx];
+    }
+
+    // her derlemede sinir kontrollu erisim
+    T& at(int idx) {
+        if (idx < 0 || idx >= len) sinirHatasi(idx, len);
         return data[idx];
     }
 
     int size() const { return len; }
+    int capacity() const { return cap; }
+    T* ptr() { return data; }
+    const T* ptr() const { return data; }
+
+    T* begin() { return data; }
+    T* end() { return data + len; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + len; }
 };
 
+// Monoton bellek alani: nesneler buyuyen bloklardan sirayla ayrilir, tek tek serbest
+// birakilmaz; temizle() tum bloklari tek seferde geri verir. Yikici cagrilmaz, bu yuzden
+// yalnizca kendi bellegi de ayni alanda olan nesneler (dugumler, kenarlar) icin kullanilir.
+class Arena {
+private:
+    struct Blok {
+        Blok* onceki;
+        size_t boyut;
+    };
+    Blok* son;
+    char* imlec;
+    char* bitis;
+    size_t sonrakiBoyut;
+
+public:
+    long long ayirmaSayisi;   // ayrilan nesne sayisi
+    long long blokSayisi;     // malloc'a giden istek sayisi
+    long long toplamBayt;
+
+    Arena(): son(nullptr), imlec(nullptr), bitis(nullptr), sonrakiBoyut(64 * 1024),
+             ayirmaSayisi(0), blokSayisi(0), toplamBayt(0) {}
+    ~Arena() { temizle(); }
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* ayir(size_t n, size_t hizalama) {
+        uintptr_t p = ((uintptr_t) imlec + hizalama - 1) & ~(uintptr_t) (hizalama - 1);
+        if (!imlec || p + n > (uintptr_t) bitis) {
+            size_t boyut = sonrakiBoyut;
+            while (boyut < n + hizalama + sizeof(Blok)) boyut *= 2;
+            Blok* b = (Blok*) std::malloc(boyut);
+            b->onceki = son; b->boyut = boyut;
+            son = b;
+            imlec = (char*) b + sizeof(Blok);
+            bitis = (char*) b + boyut;
+            if (sonrakiBoyut < 4 * 1024 * 1024) sonrakiBoyut *= 2;
+            blokSayisi++; toplamBayt += boyut;
+            p = ((uintptr_t) imlec + hizalama - 1) & ~(uintptr_t) (hizalama - 1);
+        }
+        imlec = (char*) (p + n);
+        ayirmaSayisi++;
+        return (void*) p;
+    }
+
+    template <typename T, typename... A>
+    T* yeni(A&&... args) { return new (ayir(sizeof(T), alignof(T))) T(std::forward<A>(args)...); }
+
+    void temizle() {
+        while (son) { Blok* o = son->onceki; std::free(son); son = o; }
+        imlec = bitis = nullptr;
+        sonrakiBoyut = 64 * 1024;
+    }
+};
+
+// Arena kullanilmadiginda (--arenasiz) tek tek new ile yapilan dugum ayirmalari
+static long long tekilAyirmaSayisi = 0;
+
+// Dugum ayir: arena verilmisse oradan, yoksa new ile
+template <typename T, typename... A>
+static T* dugumAyir(Arena* a, A&&... args) {
+    if (a) return a->yeni<T>(std::forward<A>(args)...);
+    tekilAyirmaSayisi++;
+    return new T(std::forward<A>(args)...);
+}
+
 template <typename T>
 struct BagliNode {
     T val;
@@ -55,15 +240,21 @@ struct BagliNode {
     BagliNode(const T& v): val(v), next(nullptr) {}
 };
 
+// arena verilirse dugumler oradan ayrilir ve liste yikilirken tek tek silinmez
 template <typename T>
 class BagliList {
 private:
     BagliNode<T>* bas;
     BagliNode<T>* son;
+    Arena* arena;
 
 public:
-    BagliList(): bas(nullptr), son(nullptr) {}
+    BagliList(Arena* a = nullptr): bas(nullptr), son(nullptr), arena(a) {}
+    BagliList(const BagliList&) = delete;
+    BagliList& operator=(const BagliList&) = delete;
+    BagliList(BagliList&& o): bas(o.bas), son(o.son), arena(o.arena) { o.bas = o.son = nullptr; }
     ~BagliList() {
+        if (arena) return;
         BagliNode<T>* cur = bas;
         while (cur) {
             BagliNode<T>* nx = cur->next;
@@ -73,7 +264,7 @@ public:
     }
 
     void pushEnd(const T& v) {
-        BagliNode<T>* node = new BagliNode<T>(v);
+        BagliNode<T>* node = dugumAyir< BagliNode<T> >(arena, v);
         if (!bas) {
             bas = son = node;
         } else {
@@ -85,6 +276,155 @@ public:
     BagliNode<T>* head() const { return bas; }
 };
 
+// OLCUM: sicak yol sayaclari ve sure histogramlari. Yalnizca -DULASIM_OLCUM ile derlenir; bayrak
+// yoksa OLCUM_* makrolari bos genisler ve uretilen kod olcumsuz surumle aynidir. Her is parcacigi
+// kendi defterine kilitsiz yazar, rapor tum defterleri toplar. Sureler nanosaniye cinsinden log2
+// kovalarda tutulur; yuzdelikler kova ust sinirindan tahmin edilir
+#ifdef ULASIM_OLCUM
+enum OlcumSayaci {
+    S_HEAP_EKLE, S_HEAP_AZALT, S_HEAP_CIKAR, S_GEVSETME, S_YERLESEN, S_AYIRMA, S_AYIRMA_BAYT, SAYAC_ADEDI
+};
+enum OlcumSuresi {
+    Z_YUKLEME_DURAK, Z_YUKLEME_HAT, Z_YUKLEME_MESAFE, Z_YUKLEME_HAT_KENAR, Z_YUKLEME_CSR,
+    Z_SORGU, Z_SORGU_YOLCU, Z_SORGU_ARAMA, Z_SORGU_ROTA, Z_SORGU_ETIKET, SURE_ADEDI
+};
+static const int OLCUM_KOVA = 40;      // kova k: [2^k, 2^(k+1)) ns, sonuncusu tasani da alir
+
+struct OlcumDefteri {
+    std::atomic<long long> sayac[SAYAC_ADEDI];
+    std::atomic<long long> kova[SURE_ADEDI][OLCUM_KOVA];
+    std::atomic<long long> toplamNs[SURE_ADEDI];
+    std::atomic<long long> enCokNs[SURE_ADEDI];
+    OlcumDefteri* sonraki;
+};
+
+static std::atomic<OlcumDefteri*> olcumDefterleri(nullptr);
+
+// Defterler is parcacigi bitse de listede kalir (raporda birikimli sayilir)
+static OlcumDefteri* olcumDefteriAc() {
+    OlcumDefteri* d = new OlcumDefteri();
+    d->sonraki = olcumDefterleri.load();
+    while (!olcumDefterleri.compare_exchange_weak(d->sonraki, d)) {}
+    return d;
+}
+
+static inline OlcumDefteri& olcumDefteri() {
+    static thread_local OlcumDefteri* d = olcumDefteriAc();
+    return *d;
+}
+
+// Defteri yalnizca sahibi yazar: oku-yaz kilitli islem gerektirmez, rapor yirtilmamis deger okur
+static inline void olcumEkle(std::atomic<long long>& a, long long n) {
+    a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+static void olcumSureEkle(int no, std::chrono::steady_clock::time_point bas) {
+    long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - bas).count();
+    OlcumDefteri& d = olcumDefteri();
+    int k = 0;
+    while (k + 1 < OLCUM_KOVA && (1LL << (k + 1)) <= ns) ++k;
+    olcumEkle(d.kova[no][k], 1);
+    olcumEkle(d.toplamNs[no], ns);
+    if (ns > d.enCokNs[no].load(std::memory_order_relaxed)) d.enCokNs[no].store(ns, std::memory_order_relaxed);
+}
+
+// Kapsam sonunda suresini kaydeder
+struct OlcumZamanlayici {
+    int no;
+    std::chrono::steady_clock::time_point bas;
+    explicit OlcumZamanlayici(int n): no(n), bas(std::chrono::steady_clock::now()) {}
+    ~OlcumZamanlayici() { olcumSureEkle(no, bas); }
+};
+
+#define OLCUM_SAY(no, n) olcumEkle(olcumDefteri().sayac[no], (n))
+#define OLCUM_KAPSAM(no) OlcumZamanlayici olcumKapsam_##no(no)
+#define OLCUM_BASLA(no) std::chrono::steady_clock::time_point olcumBas_##no = std::chrono::steady_clock::now()
+#define OLCUM_BITIR(no) olcumSureEkle(no, olcumBas_##no)
+
+// Yardimci: kova sinirini (ns) okunur birimle yaz
+static void olcumSureBicimle(char* buf, int boy, double ns) {
+    if (ns < 1e3) std::snprintf(buf, boy, "%.0fns", ns);
+    else if (ns < 1e6) std::snprintf(buf, boy, "%.1fus", ns / 1e3);
+    else if (ns < 1e9) std::snprintf(buf, boy, "%.1fms", ns / 1e6);
+    else std::snprintf(buf, boy, "%.1fs", ns / 1e9);
+}
+
+// Tum defterlerin toplami: sayaclar, her sure icin adet/ortalama/yuzdelikler ve dolu kovalar
+static void olcumRaporuYaz(FILE* out) {
+    static const char* sayacAdi[SAYAC_ADEDI] = {
+        "heap ekleme", "heap anahtar azaltma", "heap cikarma", "kenar gevsetme", "yerlesen dugum",
+        "yigin ayirma", "yigin ayirma (bayt)"
+    };
+    static const char* sureAdi[SURE_ADEDI] = {
+        "yukleme: duraklar", "yukleme: hatlar", "yukleme: mesafeler", "yukleme: hat->kenar", "yukleme: CSR",
+        "sorgu (toplam)", "  yolcu arama", "  rota arama", "    rota cikarma", "  hat etiketleme"
+    };
+    long long sayac[SAYAC_ADEDI] = {0};
+    long long kova[SURE_ADEDI][OLCUM_KOVA];
+    long long toplam[SURE_ADEDI] = {0}, enCok[SURE_ADEDI] = {0};
+    std::memset(kova, 0, sizeof(kova));
+    int defterSayisi = 0;
+    for (OlcumDefteri* d = olcumDefterleri.load(); d; d = d->sonraki) {
+        defterSayisi++;
+        for (int i = 0; i < SAYAC_ADEDI; ++i) sayac[i] += d->sayac[i].load(std::memory_order_relaxed);
+        for (int z = 0; z < SURE_ADEDI; ++z) {
+            for (int k = 0; k < OLCUM_KOVA; ++k) kova[z][k] += d->kova[z][k].load(std::memory_order_relaxed);
+            toplam[z] += d->toplamNs[z].load(std::memory_order_relaxed);
+            long long m = d->enCokNs[z].load(std::memory_order_relaxed);
+            if (m > enCok[z]) enCok[z] = m;
+        }
+    }
+    std::fprintf(out, "Olcum (%d is parcacigi defteri)\n", defterSayisi);
+    for (int i = 0; i < SAYAC_ADEDI; ++i) std::fprintf(out, "  %-22s %15lld\n", sayacAdi[i], sayac[i]);
+    std::fprintf(out, "%-24s %9s %11s %9s %9s %9s %9s %9s\n", "Sure", "adet", "toplam ms", "ort", "p50", "p90", "p99", "en cok");
+    for (int z = 0; z < SURE_ADEDI; ++z) {
+        long long adet = 0;
+        for (int k = 0; k < OLCUM_KOVA; ++k) adet += kova[z][k];
+        if (adet == 0) continue;
+        char ort[16], p[3][16], m[16];
+        const double oran[3] = { 0.50, 0.90, 0.99 };
+        for (int q = 0; q < 3; ++q) {
+            long long hedef = (long long) (oran[q] * adet), birikim = 0;
+            int k = 0;
+            for (; k < OLCUM_KOVA - 1; ++k) { birikim += kova[z][k]; if (birikim > hedef) break; }
+            double ust = (double) (1LL << (k + 1));
+            olcumSureBicimle(p[q], sizeof(p[q]), ust < enCok[z] ? ust : (double) enCok[z]);
+        }
+        olcumSureBicimle(ort, sizeof(ort), (double) toplam[z] / adet);
+        olcumSureBicimle(m, sizeof(m), (double) enCok[z]);
+        std::fprintf(out, "%-24s %9lld %11.2f %9s %9s %9s %9s %9s\n", sureAdi[z], adet, toplam[z] / 1e6, ort, p[0], p[1], p[2], m);
+        std::fprintf(out, "    dagilim:");
+        for (int k = 0; k < OLCUM_KOVA; ++k) {
+            if (!kova[z][k]) continue;
+            char ust[16];
+            olcumSureBicimle(ust, sizeof(ust), (double) (1LL << (k + 1)));
+            std::fprintf(out, " <%s:%lld", ust, kova[z][k]);
+        }
+        std::fprintf(out, "\n");
+    }
+}
+
+// Sayaclari sifirlar; eszamanli yazilan birkac artis kaybolabilir
+static void olcumSifirla() {
+    for (OlcumDefteri* d = olcumDefterleri.load(); d; d = d->sonraki) {
+        for (int i = 0; i < SAYAC_ADEDI; ++i) d->sayac[i].store(0, std::memory_order_relaxed);
+        for (int z = 0; z < SURE_ADEDI; ++z) {
+            for (int k = 0; k < OLCUM_KOVA; ++k) d->kova[z][k].store(0, std::memory_order_relaxed);
+            d->toplamNs[z].store(0, std::memory_order_relaxed);
+            d->enCokNs[z].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+#else
+#define OLCUM_SAY(no, n) ((void) 0)
+#define OLCUM_KAPSAM(no) ((void) 0)
+#define OLCUM_BASLA(no) ((void) 0)
+#define OLCUM_BITIR(no) ((void) 0)
+
+static void olcumRaporuYaz(FILE* out) { std::fprintf(out, "Olcum kapali (-DULASIM_OLCUM ile derleyin)\n"); }
+static void olcumSifirla() {}
+#endif
+
 struct HeapN {
     int vertex;
     int dist;
@@ -130,12 +470,14 @@ public:
     MinHeap(int vertexCount) {
         arr = VecArr<HeapN>();
         pos = (int*) std::malloc(sizeof(int) * vertexCount);
+        OLCUM_SAY(S_AYIRMA, 1); OLCUM_SAY(S_AYIRMA_BAYT, (long long) sizeof(int) * vertexCount);
     }
     ~MinHeap() { std::free(pos); }
 
     bool isEmpty() const { return arr.size() == 0; }
 
     void insert(int v, int d) {
+        OLCUM_SAY(S_HEAP_EKLE, 1);
         HeapN hn; hn.vertex = v; hn.dist = d;
         arr.pushLast(hn);
         int i = arr.size() - 1;
@@ -144,6 +486,7 @@ public:
     }
 
     HeapN extractMin() {
+        OLCUM_SAY(S_HEAP_CIKAR, 1);
         HeapN root = arr[0];
         HeapN last = arr[arr.size() - 1];
         arr[0] = last;
@@ -156,53 +499,348 @@ public:
     void decreaseKey(int v, int newDist) {
         int i = pos[v];
         if (i < 0 || i >= arr.size()) return;
+        OLCUM_SAY(S_HEAP_AZALT, 1);
         arr[i].dist = newDist;
         siftUp(i);
     }
+
+    int minDist() const { return arr[0].dist; }
+};
+
+
+// Dijkstra icin indeksli d-li yigin: dugumler ilk kesfedildiginde eklenir (tum dugumler
+// onceden yuklenmez), elemeler dongu ile yapilir ve ham dizilere dogrudan erisilir.
+// Derece derleme zamaninda secilir: -DHEAP_DERECE=2 ikili yigin, varsayilan 4'lu.
+#ifndef HEAP_DERECE
+#define HEAP_DERECE 4
+#endif
+
+template <int D>
+class IndeksliHeap {
+private:
+    HeapN* a;
+    int n;
+    int* pos;            // dugum -> yigindaki yeri, -1 = yiginda degil
+
+    void siftUp(int i) {
+        HeapN x = a[i];
+        while (i > 0) {
+            int p = (i - 1) / D;
+            if (a[p].dist <= x.dist) break;
+            a[i] = a[p];
+            pos[a[i].vertex] = i;
+            i = p;
+        }
+        a[i] = x;
+        pos[x.vertex] = i;
+    }
+
+    void siftDown(int i) {
+        HeapN x = a[i];
+        while (true) {
+            int c = D * i + 1;
+            if (c >= n) break;
+            int son = c + D < n ? c + D : n;
+            int enKucuk = c;
+            for (int k = c + 1; k < son; ++k)
+                if (a[k].dist < a[enKucuk].dist) enKucuk = k;
+            if (a[enKucuk].dist >= x.dist) break;
+            a[i] = a[enKucuk];
+            pos[a[i].vertex] = i;
+            i = enKucuk;
+        }
+        a[i] = x;
+        pos[x.vertex] = i;
+    }
+
+public:
+    IndeksliHeap(int vertexCount): n(0) {
+        int k = vertexCount > 0 ? vertexCount : 1;
+        a = (HeapN*) std::malloc(sizeof(HeapN) * k);
+        pos = (int*) std::malloc(sizeof(int) * k);
+        for (int i = 0; i < k; ++i) pos[i] = -1;
+        OLCUM_SAY(S_AYIRMA, 2); OLCUM_SAY(S_AYIRMA_BAYT, (long long) (sizeof(HeapN) + sizeof(int)) * k);
+    }
+    ~IndeksliHeap() { std::free(a); std::free(pos); }
+
+    bool isEmpty() const { return n == 0; }
+    bool contains(int v) const { return pos[v] >= 0; }
+    int minDist() const { return a[0].dist; }
+
+    void insert(int v, int d) {
+        OLCUM_SAY(S_HEAP_EKLE, 1);
+        a[n].vertex = v; a[n].dist = d;
+        siftUp(n++);
+    }
+
+    HeapN extractMin() {
+        OLCUM_SAY(S_HEAP_CIKAR, 1);
+        HeapN root = a[0];
+        pos[root.vertex] = -1;
+        if (--n > 0) {
+            a[0] = a[n];
+            siftDown(0);
+        }
+        return root;
+    }
+
+    void decreaseKey(int v, int newDist) {
+        int i = pos[v];
+        if (i < 0) return;
+        OLCUM_SAY(S_HEAP_AZALT, 1);
+        a[i].dist = newDist;
+        siftUp(i);
+    }
+
+    // yiginda yoksa ekle, varsa anahtari kucult
+    void insertOrDecrease(int v, int d) {
+        if (pos[v] < 0) insert(v, d);
+        else decreaseKey(v, d);
+    }
+
+    // kalan elemanlari atar; yigin yeniden ayirmadan tekrar kullanilir
+    void clear() {
+        for (int i = 0; i < n; ++i) pos[a[i].vertex] = -1;
+        n = 0;
+    }
 };
 
+typedef IndeksliHeap<HEAP_DERECE> OncelikKuyrugu;
 
 
 struct Edge {
     int dest;
     int weight;
     BagliList<int> lineList;
-    Edge(int d=0,int w=0): dest(d), weight(w) {}
+    Edge(int d=0,int w=0,Arena* a=nullptr): dest(d), weight(w), lineList(a) {}
+};
+
+// Yardimci: FNV-1a ozeti (h onceki ozetten devam eder)
+static unsigned fnvOzet(const void* p, long long n, unsigned h = 2166136261u) {
+    const unsigned char* b = (const unsigned char*) p;
+    for (long long i = 0; i < n; ++i) { h ^= b[i]; h *= 16777619u; }
+    return h;
+}
+
+// Ag anlik goruntusu (--derle / --ag): basligin ardindan ardisik bolumler gelir. Her bolum
+// 8 baytlik uzunluk ve 8'e hizalanmis ham diziden olusur, boylece mmap'lenmis dosyadaki
+// diziler oldugu yerde kullanilabilir
+struct AnlikYazici {
+    FILE* f;
+    long long yazilan;
+    unsigned toplam;     // baslik sonrasi her seyin ozeti
+    bool ok;
+
+    AnlikYazici(FILE* dosya): f(dosya), yazilan(0), toplam(2166136261u), ok(true) {}
+
+    void ham(const void* p, long long n) {
+        if (n <= 0) return;
+        toplam = fnvOzet(p, n, toplam);
+        if (std::fwrite(p, 1, n, f) != (size_t) n) ok = false;
+        yazilan += n;
+    }
+
+    template<typename T>
+    void dizi(const T* p, long long adet) {
+        static const char sifir[8] = {0};
+        long long bayt = adet * (long long) sizeof(T);
+        ham(&bayt, sizeof(bayt));
+        ham(p, bayt);
+        ham(sifir, (8 - bayt % 8) % 8);
+    }
+};
+
+struct AnlikOkuyucu {
+    const char* taban;
+    long long boyut;
+    long long konum;
+    bool ok;             // bir bolum tasarsa false kalir, sonraki okumalar nullptr doner
+
+    AnlikOkuyucu(const char* p, long long n): taban(p), boyut(n), konum(0), ok(true) {}
+
+    // Sonraki bolumu dosyanin icinden gosterir; adet eleman sayisi
+    template<typename T>
+    const T* dizi(int& adet) {
+        adet = 0;
+        long long bayt;
+        if (!ok || konum + (long long) sizeof(bayt) > boyut) { ok = false; return nullptr; }
+        std::memcpy(&bayt, taban + konum, sizeof(bayt));
+        konum += sizeof(bayt);
+        if (bayt < 0 || bayt % sizeof(T) != 0 || bayt > boyut - konum) { ok = false; return nullptr; }
+        const T* p = (const T*) (taban + konum);
+        konum += bayt + (8 - bayt % 8) % 8;
+        adet = (int) (bayt / sizeof(T));
+        return p;
+    }
+};
+
+// Yukleme bittikten sonra dondurulan sikistirilmis (CSR) komsuluk:
+// u'nun kenarlari [offset[u], offset[u+1]), e kenarinin hatlari [lineOff[e], lineOff[e+1])
+struct CSRGraf {
+    int V;
+    int E;
+    int* offset;
+    int* dest;
+    int* weight;
+    int* lineOff;
+    int* linePool;
+    bool sahip;          // false: diziler anlik goruntu dosyasinin icini gosterir
+    // (u, v) -> ilk kenar indeksi; acik adresli hash (anahtar u*V+v, -1 = bos). Her zaman bellekte
+    long long* kenarAnahtar;
+    int* kenarNo;
+    int kenarCap;        // 2'nin kuvveti
+    // Canli guncelleme: kapali duraga giren kenarlar kendi ucuna dondurulur (dest[e] = u), asilDest
+    // kenarin gercek hedefini tutar. Ikisi de ilk guncellemede ayrilir, oncesinde nullptr
+    int* asilDest;
+    unsigned char* kapali;
+
+    CSRGraf(): V(0), E(0), offset(nullptr), dest(nullptr), weight(nullptr), lineOff(nullptr), linePool(nullptr), sahip(true),
+               kenarAnahtar(nullptr), kenarNo(nullptr), kenarCap(0), asilDest(nullptr), kapali(nullptr) {}
+    ~CSRGraf() { temizle(); }
+
+    void temizle() {
+        if (sahip) {
+            std::free(offset); std::free(dest); std::free(weight);
+            std::free(lineOff); std::free(linePool);
+        }
+        std::free(kenarAnahtar); std::free(kenarNo);
+        std::free(asilDest); std::free(kapali);
+        offset = dest = weight = lineOff = linePool = nullptr;
+        kenarAnahtar = nullptr; kenarNo = nullptr; kenarCap = 0;
+        asilDest = nullptr; kapali = nullptr;
+        V = E = 0;
+        sahip = true;
+    }
+
+    static unsigned kenarHash(long long k) { return (unsigned) ((unsigned long long) k * 0x9E3779B97F4A7C15ULL >> 32); }
+
+    // Paralel kenarlarda en kucuk indeksli kenar tutulur (eski dogrusal findEdge ile ayni)
+    void kenarIndeksiKur() {
+        std::free(kenarAnahtar); std::free(kenarNo);
+        kenarCap = 16;
+        while (kenarCap < 2 * E) kenarCap *= 2;
+        kenarAnahtar = (long long*) std::malloc(sizeof(long long) * kenarCap);
+        kenarNo = (int*) std::malloc(sizeof(int) * kenarCap);
+        for (int i = 0; i < kenarCap; ++i) kenarAnahtar[i] = -1;
+        unsigned mask = kenarCap - 1;
+        for (int u = 0; u < V; ++u) {
+            for (int e = offset[u]; e < offset[u + 1]; ++e) {
+                long long k = (long long) u * V + (asilDest ? asilDest[e] : dest[e]);
+                for (unsigned i = kenarHash(k) & mask; ; i = (i + 1) & mask) {
+                    if (kenarAnahtar[i] == k) break;
+                    if (kenarAnahtar[i] == -1) { kenarAnahtar[i] = k; kenarNo[i] = e; break; }
+                }
+            }
+        }
+    }
+
+    int kenarBul(int u, int v) const {
+        if (!kenarAnahtar) return -1;
+        long long k = (long long) u * V + v;
+        unsigned mask = kenarCap - 1;
+        for (unsigned i = kenarHash(k) & mask; kenarAnahtar[i] != -1; i = (i + 1) & mask)
+            if (kenarAnahtar[i] == k) return kenarNo[i];
+        return -1;
+    }
 };
 
 class Graph {
 private:
     int V;
     VecArr< BagliList<Edge*> > adj;
+    CSRGraf csr;
+    bool frozen;
+    Arena arena;             // kenarlar, liste dugumleri ve kenar hat listeleri
+    Arena* ayirici;          // arena kapaliysa nullptr (tek tek new/delete)
+    unsigned surum;          // yapi her degistiginde artar; onbellekteki agaclar buna baglidir
 
-public:
-    Graph(int v): V(v) {
-        adj = VecArr< BagliList<Edge*> >();
-        for (int i = 0; i < V; ++i) {
-            BagliList<Edge*> l;
-            adj.pushLast(l);
+    static int* diziKopyala(const int* p, int n) {
+        int* c = (int*) std::malloc(sizeof(int) * (n > 0 ? n : 1));
+        if (n > 0) std::memcpy(c, p, sizeof(int) * n);
+        return c;
+    }
+
+    // Kapatmadan bagimsiz: u satirinda gercek hedefi v olan ilk kenar
+    int asilKenar(int u, int v) const {
+        for (int e = csr.offset[u]; e < csr.offset[u + 1]; ++e)
+            if (csr.asilDest[e] == v) return e;
+        return -1;
+    }
+
+    // u ve v satirlarinin sonuna birer kenar ekleyerek CSR'i yeniden dizer; hat havuzu aynen kalir
+    // (yeni kenarlarin hat listesi bos). Kapali uca giden yon hemen dondurulur
+    void kenarCiftiEkle(int u, int v, int w) {
+        int E = csr.E, Y = E + 2;
+        int* off = (int*) std::malloc(sizeof(int) * (V + 1));
+        int* dst = (int*) std::malloc(sizeof(int) * Y);
+        int* wgt = (int*) std::malloc(sizeof(int) * Y);
+        int* asil = (int*) std::malloc(sizeof(int) * Y);
+        int* lOff = (int*) std::malloc(sizeof(int) * (Y + 1));
+        int k = 0;
+        for (int r = 0; r < V; ++r) {
+            off[r] = k;
+            for (int e = csr.offset[r]; e < csr.offset[r + 1]; ++e) {
+                dst[k] = csr.dest[e]; wgt[k] = csr.weight[e]; asil[k] = csr.asilDest[e]; lOff[k] = csr.lineOff[e];
+                k++;
+            }
+            if (r == u || r == v) {
+                int y = (r == u) ? v : u;
+                asil[k] = y; dst[k] = csr.kapali[y] ? r : y; wgt[k] = w;
+                lOff[k] = csr.lineOff[csr.offset[r + 1]];
+                k++;
+            }
         }
+        off[V] = k;
+        lOff[Y] = csr.lineOff[E];
+        std::free(csr.offset); std::free(csr.dest); std::free(csr.weight); std::free(csr.asilDest); std::free(csr.lineOff);
+        csr.offset = off; csr.dest = dst; csr.weight = wgt; csr.asilDest = asil; csr.lineOff = lOff;
+        csr.E = Y;
+        csr.kenarIndeksiKur();
     }
-    ~Graph() {
-        for (int u = 0; u < V; ++u) {
-            BagliNode<Edge*>* node = adj[u].head();
-            while (node) {
-                delete node->val;
-                node = node->next;
+
+    void kenarlariBirak() {
+        if (!ayirici) {
+            for (int u = 0; u < V; ++u) {
+                BagliNode<Edge*>* node = adj[u].head();
+                while (node) {
+                    delete node->val;
+                    node = node->next;
+                }
             }
         }
+        adj = VecArr< BagliList<Edge*> >();
+        arena.temizle();
+    }
+
+public:
+    Graph(int v): V(0), frozen(false), ayirici(&arena), surum(0) { init(v); }
+    ~Graph() { kenarlariBirak(); }
+
+    // Dugum sayisini (yeniden) belirler; yukleyici durak sayisini ogrendikten sonra cagirir.
+    // arenaKullan false ise kenarlar tek tek new ile ayrilir (karsilastirma icin)
+    void init(int v, bool arenaKullan = true) {
+        kenarlariBirak();
+        ayirici = arenaKullan ? &arena : nullptr;
+        csr.temizle();
+        frozen = false;
+        surum++;
+        V = v;
+        adj.reserve(V);
+        for (int i = 0; i < V; ++i) adj.pushLast(BagliList<Edge*>(ayirici));
     }
 
+    const Arena& arenaBilgisi() const { return arena; }
+
     void addEdge(int u,int v,int w) {
         if (u < 0 || u >= V || v < 0 || v >= V) return;
-        Edge* e1 = new Edge(v,w);
+        Edge* e1 = dugumAyir<Edge>(ayirici, v, w, ayirici);
         adj[u].pushEnd(e1);
-        Edge* e2 = new Edge(u,w);
+        Edge* e2 = dugumAyir<Edge>(ayirici, u, w, ayirici);
         adj[v].pushEnd(e2);
     }
 
     void addLineToEdge(int u,int v,int lineNo) {
-        if (u < 0 || u >= V || v < 0 || v >= V) return;
+        if (u < 0 || u >= adj.size() || v < 0 || v >= adj.size()) return;
         BagliNode<Edge*>* node = adj[u].head();
         while (node) {
             if (node->val->dest == v) {
@@ -221,13 +859,212 @@ public:
         }
     }
 
-    void dijkstra(int src,int* dist,int* parent) {
+    // Bagli listeleri duz CSR dizilerine kopyalar; bundan sonra dijkstra ve rota CSR uzerinden calisir
+    void freeze() {
+        csr.temizle();
+        int E = 0, L = 0;
+        for (int u = 0; u < V; ++u) {
+            for (BagliNode<Edge*>* en = adj[u].head(); en; en = en->next) {
+                E++;
+                for (BagliNode<int>* hn = en->val->lineList.head(); hn; hn = hn->next) L++;
+            }
+        }
+        csr.V = V; csr.E = E;
+        csr.offset = (int*) std::malloc(sizeof(int) * (V + 1));
+        csr.dest = (int*) std::malloc(sizeof(int) * (E > 0 ? E : 1));
+        csr.weight = (int*) std::malloc(sizeof(int) * (E > 0 ? E : 1));
+        csr.lineOff = (int*) std::malloc(sizeof(int) * (E + 1));
+        csr.linePool = (int*) std::malloc(sizeof(int) * (L > 0 ? L : 1));
+        int e = 0, l = 0;
+        for (int u = 0; u < V; ++u) {
+            csr.offset[u] = e;
+            for (BagliNode<Edge*>* en = adj[u].head(); en; en = en->next) {
+                csr.dest[e] = en->val->dest;
+                csr.weight[e] = en->val->weight;
+                csr.lineOff[e] = l;
+                for (BagliNode<int>* hn = en->val->lineList.head(); hn; hn = hn->next) csr.linePool[l++] = hn->val;
+                e++;
+            }
+        }
+        csr.offset[V] = e;
+        csr.lineOff[E] = l;
+        csr.kenarIndeksiKur();
+        frozen = true;
+        surum++;
+    }
+
+    bool isFrozen() const { return frozen; }
+
+    // u->v agirligi, durak kapatmalarindan bagimsiz (tarife bolum sureleri icin); kenar yoksa -1
+    int asilAgirlik(int u, int v) const {
+        if (!frozen || u < 0 || u >= V || v < 0 || v >= V) return -1;
+        int e = csr.asilDest ? asilKenar(u, v) : findEdge(u, v);
+        return e == -1 ? -1 : csr.weight[e];
+    }
+    unsigned version() const { return surum; }
+    int vertexCount() const { return V; }
+    int edgeCount() const { return csr.E; }
+
+    // CSR komsulugun (offset, dest, weight) ozeti; diske yazilan tablolar kuruldugu agi bununla tanir
+    unsigned csrOzet() const {
+        unsigned h = fnvOzet(csr.offset, sizeof(int) * (long long) (V + 1));
+        h = fnvOzet(csr.dest, sizeof(int) * (long long) csr.E, h);
+        return fnvOzet(csr.weight, sizeof(int) * (long long) csr.E, h);
+    }
+
+    // CSR erisimcileri (freeze sonrasi)
+    int edgeBegin(int u) const { return csr.offset[u]; }
+    int edgeEnd(int u) const { return csr.offset[u + 1]; }
+    int edgeDest(int e) const { return csr.dest[e]; }
+    int edgeWeight(int e) const { return csr.weight[e]; }
+    const int* edgeLinesBegin(int e) const { return csr.linePool + csr.lineOff[e]; }
+    const int* edgeLinesEnd(int e) const { return csr.linePool + csr.lineOff[e + 1]; }
+
+    // u->v kenarinin CSR indeksi (paralel kenarlarda ilki), yoksa -1. Kisa komsuluk dogrudan
+    // taranir (tek onbellek satiri), uzunu hash ile O(1) bulunur
+    int findEdge(int u,int v) const {
+        if (!frozen || u < 0 || u >= V || v < 0 || v >= V) return -1;
+        if (csr.offset[u + 1] - csr.offset[u] > 16) {
+            int e = csr.kenarBul(u, v);
+            return (e != -1 && csr.dest[e] == v) ? e : -1;     // kapali duraga giden kenar sayilmaz
+        }
+        for (int e = csr.offset[u]; e < csr.offset[u + 1]; ++e)
+            if (csr.dest[e] == v) return e;
+        return -1;
+    }
+
+    // Eski komsuluk taramasi; yalnizca olcum karsilastirmasi icin
+    int findEdgeLineer(int u,int v) const {
+        if (!frozen || u < 0 || u >= V) return -1;
+        for (int e = csr.offset[u]; e < csr.offset[u + 1]; ++e)
+            if (csr.dest[e] == v) return e;
+        return -1;
+    }
+
+    void dijkstra(int src,int* dist,int* parent) const {
         if (src < 0 || src >= V) return;
         for (int i = 0; i < V; ++i) {
             dist[i] = INT_MAX;
             parent[i] = -1;
         }
         dist[src] = 0;
+        OncelikKuyrugu pq(V);
+        pq.insert(src, 0);
+        const int* off = csr.offset;
+        const int* dst = csr.dest;
+        const int* wgt = csr.weight;
+        while (!pq.isEmpty()) {
+            HeapN hn = pq.extractMin();
+            int u = hn.vertex;
+            int du = hn.dist;
+            OLCUM_SAY(S_YERLESEN, 1); OLCUM_SAY(S_GEVSETME, off[u + 1] - off[u]);
+            for (int e = off[u]; e < off[u + 1]; ++e) {
+                int v = dst[e];
+                int nd = du + wgt[e];
+                if (nd < dist[v]) {
+                    pq.insertOrDecrease(v, nd);
+                    dist[v] = nd;
+                    parent[v] = u;
+                }
+            }
+        }
+    }
+
+    // Tek hedefli dijkstra: dugumler ilk kesfedildiklerinde yiguna girer, hedef yerlestiginde durur.
+    // dist[dst] (yol yoksa INT_MAX) doner; settled yerlesen dugum sayisi
+    int dijkstraHedef(int src,int dst,int* dist,int* parent,int& settled) const {
+        settled = 0;
+        if (src < 0 || src >= V || dst < 0 || dst >= V) return INT_MAX;
+        for (int i = 0; i < V; ++i) {
+            dist[i] = INT_MAX;
+            parent[i] = -1;
+        }
+        dist[src] = 0;
+        OncelikKuyrugu pq(V);
+        pq.insert(src, 0);
+        const int* off = csr.offset;
+        const int* dst_ = csr.dest;
+        const int* wgt = csr.weight;
+        while (!pq.isEmpty()) {
+            HeapN hn = pq.extractMin();
+            int u = hn.vertex;
+            settled++;
+            if (u == dst) break;
+            int du = hn.dist;
+            OLCUM_SAY(S_YERLESEN, 1); OLCUM_SAY(S_GEVSETME, off[u + 1] - off[u]);
+            for (int e = off[u]; e < off[u + 1]; ++e) {
+                int v = dst_[e];
+                int nd = du + wgt[e];
+                if (nd < dist[v]) {
+                    pq.insertOrDecrease(v, nd);
+                    dist[v] = nd;
+                    parent[v] = u;
+                }
+            }
+        }
+        return dist[dst];
+    }
+
+    // Cift yonlu dijkstra (kenarlar iki yonlu eklendigi icin geri arama ayni komsulugu kullanir).
+    // Iki taraftan kucuk yigini olan ilerler; en iyi bulusma mu'dan kucuk bir sey kalmayinca durur.
+    // Rota path'e (src..dst) yazilir, uzunlugu doner (yol yoksa 0); settled iki taraftaki toplam
+    int dijkstraCiftYonlu(int src,int dst,int* distF,int* parF,int* distB,int* parB,int* path,int& settled) const {
+        settled = 0;
+        if (src < 0 || src >= V || dst < 0 || dst >= V) return 0;
+        if (src == dst) { path[0] = src; return 1; }
+        for (int i = 0; i < V; ++i) {
+            distF[i] = distB[i] = INT_MAX;
+            parF[i] = parB[i] = -1;
+        }
+        distF[src] = 0; distB[dst] = 0;
+        OncelikKuyrugu hF(V), hB(V);
+        hF.insert(src, 0); hB.insert(dst, 0);
+        int mu = INT_MAX, bulusma = -1;
+        while (!hF.isEmpty() && !hB.isEmpty()) {
+            if ((long long) hF.minDist() + hB.minDist() >= mu) break;
+            bool ileri = true;
+            // en kucuk anahtari kucuk olan tarafi ilerlet
+            if (hB.minDist() < hF.minDist()) ileri = false;
+            OncelikKuyrugu& h = ileri ? hF : hB;
+            int* d = ileri ? distF : distB;
+            int* par = ileri ? parF : parB;
+            const int* karsi = ileri ? distB : distF;
+            HeapN hn = h.extractMin();
+            int u = hn.vertex;
+            settled++;
+            int du = d[u];
+            OLCUM_SAY(S_YERLESEN, 1); OLCUM_SAY(S_GEVSETME, csr.offset[u + 1] - csr.offset[u]);
+            for (int e = csr.offset[u]; e < csr.offset[u + 1]; ++e) {
+                int v = csr.dest[e];
+                int nd = du + csr.weight[e];
+                if (nd < d[v]) {
+                    h.insertOrDecrease(v, nd);
+                    d[v] = nd;
+                    par[v] = u;
+                }
+                if (karsi[v] != INT_MAX && d[v] != INT_MAX && d[v] + karsi[v] < mu) {
+                    mu = d[v] + karsi[v];
+                    bulusma = v;
+                }
+            }
+        }
+        if (bulusma == -1) return 0;
+        OLCUM_KAPSAM(Z_SORGU_ROTA);
+        int n = 0;
+        for (int x = bulusma; x != -1; x = parF[x]) path[n++] = x;
+        for (int i = 0; i < n / 2; ++i) { int t = path[i]; path[i] = path[n - 1 - i]; path[n - 1 - i] = t; }
+        for (int x = parB[bulusma]; x != -1; x = parB[x]) path[n++] = x;
+        return n;
+    }
+
+    // Bagli liste (Edge*) uzerinde eski dijkstra; karsilastirma icin duruyor
+    void dijkstraListe(int src,int* dist,int* parent) {
+        if (src < 0 || src >= V || !listeVar()) return;
+        for (int i = 0; i < V; ++i) {
+            dist[i] = INT_MAX;
+            parent[i] = -1;
+        }
+        dist[src] = 0;
         MinHeap mh(V);
         for (int i = 0; i < V; ++i) {
             mh.insert(i, dist[i]);
@@ -249,9 +1086,150 @@ public:
         }
     }
 
+    // Anlik goruntu yalnizca CSR dizilerini tasir; bagli listeler yuklemeden sonra kullanilmaz
+    void anlikYaz(AnlikYazici& y) const {
+        y.dizi(csr.offset, V + 1);
+        y.dizi(csr.dest, csr.E);
+        y.dizi(csr.weight, csr.E);
+        y.dizi(csr.lineOff, csr.E + 1);
+        y.dizi(csr.linePool, csr.lineOff[csr.E]);
+    }
+
+    // CSR dizilerini dosyanin icinden gosterir; bagli liste kurulmaz (dijkstraListe kullanilamaz)
+    bool anlikBagla(AnlikOkuyucu& o) {
+        init(0);
+        int nOff, nDest, nW, nLOff, nL;
+        const int* off = o.dizi<int>(nOff);
+        const int* dst = o.dizi<int>(nDest);
+        const int* wgt = o.dizi<int>(nW);
+        const int* lOff = o.dizi<int>(nLOff);
+        const int* lPool = o.dizi<int>(nL);
+        if (!o.ok || nOff < 1 || nW != nDest || nLOff != nDest + 1 || off[nOff - 1] != nDest || lOff[nDest] != nL) return false;
+        V = nOff - 1;
+        csr.V = V; csr.E = nDest;
+        csr.offset = const_cast<int*>(off);
+        csr.dest = const_cast<int*>(dst);
+        csr.weight = const_cast<int*>(wgt);
+        csr.lineOff = const_cast<int*>(lOff);
+        csr.linePool = const_cast<int*>(lPool);
+        csr.sahip = false;
+        csr.kenarIndeksiKur();
+        frozen = true;
+        surum++;
+        return true;
+    }
+
+    // CANLI GUNCELLEME
+    // Ag yeniden okunmadan degistirilir; her degisiklik surumu artirir (onbellekteki agaclar
+    // gecersizlesir). Arama donguleri degismez: kapali duraga giren kenar kendi ucuna dondurulur
+    // (u->u); gevseme onu hicbir zaman iyilestirmediginden duraktan gecilemez. Agirlik ve kapatma
+    // yerinde, kenar ekleme ve hat degisikligi CSR dizilerinin tek seferlik yeniden dizilmesidir
+
+    bool durakKapaliMi(int u) const { return csr.kapali && u >= 0 && u < V && csr.kapali[u]; }
+
+    // Ilk guncellemeden once: anlik goruntu dizileri bellege kopyalanir (dosya salt okunur
+    // eslenmistir), artik eskiyecek bagli listeler birakilir, asilDest ve kapali ayrilir
+    void guncellemeyeHazirla() {
+        if (csr.asilDest) return;
+        if (!csr.sahip) {
+            csr.offset = diziKopyala(csr.offset, V + 1);
+            csr.dest = diziKopyala(csr.dest, csr.E);
+            csr.weight = diziKopyala(csr.weight, csr.E);
+            csr.linePool = diziKopyala(csr.linePool, csr.lineOff[csr.E]);
+            csr.lineOff = diziKopyala(csr.lineOff, csr.E + 1);
+            csr.sahip = true;
+        }
+        kenarlariBirak();
+        csr.asilDest = diziKopyala(csr.dest, csr.E);
+        csr.kapali = (unsigned char*) std::calloc(V > 0 ? V : 1, 1);
+    }
+
+    bool durakKapat(int s) {
+        if (!frozen || s < 0 || s >= V) return false;
+        guncellemeyeHazirla();
+        if (csr.kapali[s]) return false;
+        csr.kapali[s] = 1;
+        for (int e = csr.offset[s]; e < csr.offset[s + 1]; ++e) {
+            int x = csr.asilDest[e];
+            for (int f = csr.offset[x]; f < csr.offset[x + 1]; ++f)
+                if (csr.asilDest[f] == s) csr.dest[f] = x;
+        }
+        surum++;
+        return true;
+    }
+
+    bool durakAc(int s) {
+        if (!durakKapaliMi(s)) return false;
+        csr.kapali[s] = 0;
+        for (int e = csr.offset[s]; e < csr.offset[s + 1]; ++e) {
+            int x = csr.asilDest[e];
+            for (int f = csr.offset[x]; f < csr.offset[x + 1]; ++f)
+                if (csr.asilDest[f] == s) csr.dest[f] = s;
+        }
+        surum++;
+        return true;
+    }
+
+    // u-v kenarlarinin (iki yon, paralel olanlar dahil) agirligini w yapar; kenar yoksa yeni bir
+    // cift ekler. Guncellenen kenar sayisini, eklendiyse 0, gecersiz istekte -1 doner
+    int kenarAyarla(int u, int v, int w) {
+        if (!frozen || u < 0 || u >= V || v < 0 || v >= V || u == v || w < 0) return -1;
+        guncellemeyeHazirla();
+        int n = 0;
+        for (int e = csr.offset[u]; e < csr.offset[u + 1]; ++e) if (csr.asilDest[e] == v) { csr.weight[e] = w; n++; }
+        for (int e = csr.offset[v]; e < csr.offset[v + 1]; ++e) if (csr.asilDest[e] == u) { csr.weight[e] = w; n++; }
+        if (n == 0) kenarCiftiEkle(u, v, w);
+        surum++;
+        return n;
+    }
+
+    // Hattin durak dizisindeki (1 tabanli ID) ardisik ciftlerin kenarlarina hatNo ekler ya da
+    // bir kez cikarir; addLineToEdge gibi her yonde ilk kenar etiketlenir. Hat havuzu yeniden dizilir
+    void hatKenarlariniDegistir(const int* duraklar, int n, int hatNo, bool ekle) {
+        if (!frozen) return;
+        guncellemeyeHazirla();
+        int E = csr.E;
+        int* fark = (int*) std::calloc(E > 0 ? E : 1, sizeof(int));
+        long long toplam = 0;
+        for (int i = 0; i + 1 < n; ++i) {
+            int u = duraklar[i] - 1, v = duraklar[i + 1] - 1;
+            if (u < 0 || u >= V || v < 0 || v >= V) continue;
+            int e = asilKenar(u, v);
+            if (e != -1) { fark[e]++; toplam++; }
+            e = asilKenar(v, u);
+            if (e != -1) { fark[e]++; toplam++; }
+        }
+        int L = csr.lineOff[E];
+        int* lOff = (int*) std::malloc(sizeof(int) * (E + 1));
+        int* havuz = (int*) std::malloc(sizeof(int) * (L + (ekle ? toplam : 0) + 1));
+        int k = 0;
+        for (int e = 0; e < E; ++e) {
+            lOff[e] = k;
+            int bas = k;
+            for (int i = csr.lineOff[e]; i < csr.lineOff[e + 1]; ++i) havuz[k++] = csr.linePool[i];
+            if (ekle) {
+                for (int j = 0; j < fark[e]; ++j) havuz[k++] = hatNo;
+            } else {
+                // sondan baslayarak fark[e] tanesini cikar, kalanlarin sirasi korunur
+                for (int j = k - 1; j >= bas && fark[e] > 0; --j) {
+                    if (havuz[j] != hatNo) continue;
+                    for (int t = j; t + 1 < k; ++t) havuz[t] = havuz[t + 1];
+                    k--; fark[e]--;
+                }
+            }
+        }
+        lOff[E] = k;
+        std::free(fark);
+        std::free(csr.lineOff); std::free(csr.linePool);
+        csr.lineOff = lOff; csr.linePool = havuz;
+        surum++;
+    }
+
+    bool listeVar() const { return adj.size() == V; }
+
     BagliList<Edge*>& getAdj(int u) {
         static BagliList<Edge*> empty;
-        if (u < 0 || u >= V) return empty;
+        if (u < 0 || u >= adj.size()) return empty;
         return adj[u];
     }
 };
@@ -261,365 +1239,4290 @@ struct BSTNode {
     BagliList<int> hatList;
     BSTNode* left;
     BSTNode* right;
-    BSTNode(int id): durakID(id), left(nullptr), right(nullptr) {}
+    BSTNode(int id, Arena* a = nullptr): durakID(id), hatList(a), left(nullptr), right(nullptr) {}
 };
 
 class DurakHatBST {
 private:
     BSTNode* root;
+    Arena arena;
+    Arena* ayirici;
 
-    BSTNode* insertNode(BSTNode* node,int durakID,int hatNo) {
-        if (!node) {
-            node = new BSTNode(durakID);
-            node->hatList.pushEnd(hatNo);
-            return node;
-        }
-        if (durakID < node->durakID) {
-            node->left = insertNode(node->left,durakID,hatNo);
-        } else if (durakID > node->durakID) {
-            node->right = insertNode(node->right,durakID,hatNo);
-        } else {
-            node->hatList.pushEnd(hatNo);
+    // Ekleme, arama ve silme yinelemeli: sirali ID'lerle agac zincire donustugunde
+    // derinlik dugum sayisina esit olur, ozyineleme yigini tasirirdi
+    void insertNode(int durakID,int hatNo) {
+        BSTNode** yer = &root;
+        while (*yer) {
+            if (durakID < (*yer)->durakID) yer = &(*yer)->left;
+            else if (durakID > (*yer)->durakID) yer = &(*yer)->right;
+            else { (*yer)->hatList.pushEnd(hatNo); return; }
         }
-        return node;
+        *yer = dugumAyir<BSTNode>(ayirici, durakID, ayirici);
+        (*yer)->hatList.pushEnd(hatNo);
     }
 
-    BSTNode* searchNode(BSTNode* node,int durakID) const {
-        if (!node) return nullptr;
-        if (durakID < node->durakID) return searchNode(node->left,durakID);
-        else if (durakID > node->durakID) return searchNode(node->right,durakID);
-        else return node;
+    BSTNode* searchNode(int durakID) const {
+        BSTNode* node = root;
+        while (node && node->durakID != durakID)
+            node = durakID < node->durakID ? node->left : node->right;
+        return node;
     }
 
-    void deleteTree(BSTNode* node) {
-        if (!node) return;
-        deleteTree(node->left);
-        deleteTree(node->right);
-        delete node;
+    void deleteTree() {
+        VecArr<BSTNode*> yigin;
+        if (root) yigin.pushLast(root);
+        while (yigin.size() > 0) {
+            BSTNode* node = yigin[yigin.size() - 1];
+            yigin.popLast();
+            if (node->left) yigin.pushLast(node->left);
+            if (node->right) yigin.pushLast(node->right);
+            delete node;
+        }
     }
 
 public:
-    DurakHatBST(): root(nullptr) {}
-    ~DurakHatBST() { deleteTree(root); }
+    DurakHatBST(): root(nullptr), ayirici(&arena) {}
+    ~DurakHatBST() { temizle(); }
 
-    void insert(int durakID,int hatNo) { root = insertNode(root,durakID,hatNo); }
-
-    BSTNode* search(int durakID) const { return searchNode(root,durakID); }
-};
-
-// Sabitler ve Global Degiskenler 
-static const int MAX_DURAK = 114;
-static const int MAX_HAT = 100;
+    // tum dugumleri birakir; arena kullaniliyorsa tek seferde
+    void temizle() {
+        if (!ayirici) deleteTree();
+        arena.temizle();
+        root = nullptr;
+    }
 
-static char durakNameArr[MAX_DURAK + 1][256];
-static int hatNoArr[MAX_HAT];
-static char hatNameArr[MAX_HAT][256];
-static int hatSayisi = 0;
-static VecArr< VecArr<int> > hatDuraklari;
-static VecArr< VecArr<char*> > hatDurakAdlari;
-static int hatUsageArr[MAX_HAT];
+    void arenaKullan(bool acik) { temizle(); ayirici = acik ? &arena : nullptr; }
+    const Arena& arenaBilgisi() const { return arena; }
 
-static DurakHatBST durakHatAgaci;
+    void insert(int durakID,int hatNo) { insertNode(durakID,hatNo); }
 
-class Graph;
-Graph globalGraph(MAX_DURAK);
+    BSTNode* search(int durakID) const { return searchNode(durakID); }
 
-// Yardimci: Durak ismine gore id bul
-int findDurakIDbyName(const char* name) {
-    for (int i = 1; i <= MAX_DURAK; ++i) {
-        if (std::strcmp(durakNameArr[i], name) == 0) {
-            return i;
+    // en uzun kok-yaprak yolu (dugum sayisi)
+    int derinlik() const {
+        VecArr<BSTNode*> yigin; VecArr<int> seviye;
+        if (root) { yigin.pushLast(root); seviye.pushLast(1); }
+        int enDerin = 0;
+        while (yigin.size() > 0) {
+            int n = yigin.size() - 1;
+            BSTNode* node = yigin[n]; int d = seviye[n];
+            yigin.popLast(); seviye.popLast();
+            if (d > enDerin) enDerin = d;
+            if (node->left) { yigin.pushLast(node->left); seviye.pushLast(d + 1); }
+            if (node->right) { yigin.pushLast(node->right); seviye.pushLast(d + 1); }
         }
+        return enDerin;
     }
-    return -1;
+};
+
+// Durak -> hat indeksi. Yukleme sirasinda (durak, hat) ciftleri biriktirilir, sikistir()
+// bunlari durakID ile dogrudan indekslenen ofset + hat havuzuna cevirir (CSRGraf gibi).
+// Arama O(1), ekleme sirasindan bagimsiz; bir duragin hatlari eklenme sirasini korur
+class DurakHatIndeksi {
+private:
+    int enBuyukID;
+    VecArr<int> ciftDurak;
+    VecArr<int> ciftHat;
+    int* ofset;     // enBuyukID+2 eleman; durak d'nin hatlari havuz[ofset[d] .. ofset[d+1])
+    int* havuz;
+    bool sahip;     // false: diziler anlik goruntu dosyasinin icini gosterir
+
+public:
+    DurakHatIndeksi(): enBuyukID(0), ofset(nullptr), havuz(nullptr), sahip(true) {}
+    ~DurakHatIndeksi() { temizle(); }
+    DurakHatIndeksi(const DurakHatIndeksi&) = delete;
+    DurakHatIndeksi& operator=(const DurakHatIndeksi&) = delete;
+
+    void temizle() {
+        if (sahip) { std::free(ofset); std::free(havuz); }
+        ofset = nullptr; havuz = nullptr; enBuyukID = 0; sahip = true;
+        ciftDurak.clear(); ciftHat.clear();
+    }
+
+    void anlikYaz(AnlikYazici& y) const {
+        y.dizi(ofset, enBuyukID + 2);
+        y.dizi(havuz, ofset[enBuyukID + 1]);
+    }
+
+    bool anlikBagla(AnlikOkuyucu& o) {
+        temizle();
+        int nOfset, nHavuz;
+        const int* of = o.dizi<int>(nOfset);
+        const int* hv = o.dizi<int>(nHavuz);
+        if (!o.ok || nOfset < 2 || of[nOfset - 1] != nHavuz) return false;
+        enBuyukID = nOfset - 2;
+        ofset = const_cast<int*>(of); havuz = const_cast<int*>(hv);
+        sahip = false;
+        return true;
+    }
+
+    void baslat(int maxID) { temizle(); enBuyukID = maxID; }
+
+    void ekle(int durakID, int hatNo) {
+        if (durakID < 1 || durakID > enBuyukID) return;
+        ciftDurak.pushLast(durakID); ciftHat.pushLast(hatNo);
+    }
+
+    // Sayarak siralama: once durak basina hat sayisi, sonra onek toplami, sonra yerlestirme
+    void sikistir() {
+        int n = ciftDurak.size();
+        if (sahip) { std::free(ofset); std::free(havuz); }
+        sahip = true;
+        ofset = (int*) std::calloc(enBuyukID + 2, sizeof(int));
+        havuz = (int*) std::malloc((n > 0 ? n : 1) * sizeof(int));
+        if (!ofset || !havuz) { std::fprintf(stderr, "Bellek yetersiz (durak-hat indeksi)\n"); std::exit(1); }
+        for (int i = 0; i < n; ++i) ofset[ciftDurak[i] + 1]++;
+        for (int d = 1; d <= enBuyukID + 1; ++d) ofset[d] += ofset[d - 1];
+        int* yaz = (int*) std::malloc((enBuyukID + 1) * sizeof(int));
+        if (!yaz) { std::fprintf(stderr, "Bellek yetersiz (durak-hat indeksi)\n"); std::exit(1); }
+        std::memcpy(yaz, ofset, (enBuyukID + 1) * sizeof(int));
+        for (int i = 0; i < n; ++i) havuz[yaz[ciftDurak[i]]++] = ciftHat[i];
+        std::free(yaz);
+        ciftDurak.clear(); ciftDurak.shrink_to_fit();
+        ciftHat.clear(); ciftHat.shrink_to_fit();
+    }
+
+    int hatSayisi(int durakID) const {
+        if (!ofset || durakID < 1 || durakID > enBuyukID) return 0;
+        return ofset[durakID + 1] - ofset[durakID];
+    }
+
+    const int* hatlar(int durakID) const {
+        if (!ofset || durakID < 1 || durakID > enBuyukID) return nullptr;
+        return havuz + ofset[durakID];
+    }
+
+    long long bayt() const {
+        return ofset ? (long long) (enBuyukID + 2) * sizeof(int) + (long long) ofset[enBuyukID + 1] * sizeof(int) : 0;
+    }
+};
+
+// Tum ciftler en kisa yol tablosu: satir s, s kaynakli dijkstra agacindan uretilir.
+// sonraki[s*V+t] = s->t yolunda s'den sonraki dugum; rota O(yol uzunlugu) adimda cikar
+class MesafeTablosu {
+private:
+    int V;
+    int* dist;
+    int* sonraki;
+
+    struct DosyaBasligi {
+        char sihir[4];       // "ULMT"
+        int surum;
+        int V;
+        int E;
+        unsigned toplam;     // dist ve sonraki dizilerinin FNV-1a ozeti
+        unsigned agOzet;     // tablonun kuruldugu CSR'nin ozeti (Graph::csrOzet)
+    };
+
+    static unsigned ozet(const int* a, long long n, unsigned h) {
+        const unsigned char* p = (const unsigned char*) a;
+        for (long long i = 0; i < n * (long long) sizeof(int); ++i) { h ^= p[i]; h *= 16777619u; }
+        return h;
+    }
+
+    // kaynak s'nin dijkstra agacindan s satirini doldurur
+    void satirDoldur(int s, const int* d, const int* parent, int* yigin) {
+        int* ds = dist + (long long) s * V;
+        int* ns = sonraki + (long long) s * V;
+        for (int t = 0; t < V; ++t) { ds[t] = d[t]; ns[t] = -2; }
+        ns[s] = -1;
+        for (int t = 0; t < V; ++t) {
+            if (ns[t] != -2) continue;
+            if (d[t] == INT_MAX) { ns[t] = -1; continue; }
+            // agacta yukari cik: kaynaga bagli ilk dugum veya cozulmus bir dugum bulunana kadar
+            int n = 0, x = t;
+            while (ns[x] == -2 && parent[x] != s) { yigin[n++] = x; x = parent[x]; }
+            int ilk = (ns[x] == -2) ? x : ns[x];
+            if (ns[x] == -2) ns[x] = x;
+            while (n > 0) ns[yigin[--n]] = ilk;
+        }
+    }
+
+public:
+    MesafeTablosu(): V(0), dist(nullptr), sonraki(nullptr) {}
+    ~MesafeTablosu() { temizle(); }
+
+    void temizle() {
+        std::free(dist); std::free(sonraki);
+        dist = sonraki = nullptr; V = 0;
+    }
+
+    bool hazir() const { return dist != nullptr; }
+
+    // Her kaynaktan dijkstra'yi isciSayisi is parcacigina dagitarak tabloyu kurar
+    void hesapla(const Graph& g, int isciSayisi) {
+        temizle();
+        V = g.vertexCount();
+        dist = (int*) std::malloc(sizeof(int) * (long long) V * V);
+        sonraki = (int*) std::malloc(sizeof(int) * (long long) V * V);
+        if (isciSayisi < 1) isciSayisi = 1;
+        std::atomic<int> siradaki(0);
+        VecArr<std::thread*> isciler;
+        for (int i = 0; i < isciSayisi; ++i) {
+            isciler.pushLast(new std::thread([this, &g, &siradaki]() {
+                int* d = (int*) std::malloc(sizeof(int) * V);
+                int* parent = (int*) std::malloc(sizeof(int) * V);
+                int* yigin = (int*) std::malloc(sizeof(int) * V);
+                for (int s = siradaki++; s < V; s = siradaki++) {
+                    g.dijkstra(s, d, parent);
+                    satirDoldur(s, d, parent, yigin);
+                }
+                std::free(d); std::free(parent); std::free(yigin);
+            }));
+        }
+        for (int i = 0; i < isciler.size(); ++i) { isciler[i]->join(); delete isciler[i]; }
+    }
+
+    bool kaydet(const char* dosya, const Graph& g) const {
+        FILE* f = std::fopen(dosya, "wb");
+        if (!f) { std::perror(dosya); return false; }
+        long long n = (long long) V * V;
+        DosyaBasligi b;
+        std::memcpy(b.sihir, "ULMT", 4);
+        b.surum = 2; b.V = V; b.E = g.edgeCount();
+        b.toplam = ozet(sonraki, n, ozet(dist, n, 2166136261u));
+        b.agOzet = g.csrOzet();
+        bool ok = std::fwrite(&b, sizeof(b), 1, f) == 1
+               && (long long) std::fwrite(dist, sizeof(int), n, f) == n
+               && (long long) std::fwrite(sonraki, sizeof(int), n, f) == n;
+        std::fclose(f);
+        return ok;
+    }
+
+    // Tablo mevcut grafla (V, E, kenar agirliklari) eslesmiyorsa veya bozuksa yuklenmez
+    bool yukle(const char* dosya, const Graph& g) {
+        FILE* f = std::fopen(dosya, "rb");
+        if (!f) { std::perror(dosya); return false; }
+        DosyaBasligi b;
+        if (std::fread(&b, sizeof(b), 1, f) != 1 || std::memcmp(b.sihir, "ULMT", 4) != 0 || b.surum != 2) {
+            std::fprintf(stderr, "%s: gecersiz veya eski surum tablo dosyasi (--onhesap ile yeniden olusturun)\n", dosya);
+            std::fclose(f); return false;
+        }
+        if (b.V != g.vertexCount() || b.E != g.edgeCount() || b.agOzet != g.csrOzet()) {
+            std::fprintf(stderr, "%s: tablo bu aga ait degil (V=%d E=%d, beklenen V=%d E=%d%s)\n", dosya, b.V, b.E,
+                         g.vertexCount(), g.edgeCount(), b.agOzet != g.csrOzet() ? ", kenarlar farkli" : "");
+            std::fclose(f); return false;
+        }
+        temizle();
+        V = b.V;
+        long long n = (long long) V * V;
+        dist = (int*) std::malloc(sizeof(int) * n);
+        sonraki = (int*) std::malloc(sizeof(int) * n);
+        bool ok = (long long) std::fread(dist, sizeof(int), n, f) == n
+               && (long long) std::fread(sonraki, sizeof(int), n, f) == n
+               && ozet(sonraki, n, ozet(dist, n, 2166136261u)) == b.toplam;
+        std::fclose(f);
+        if (!ok) { std::fprintf(stderr, "%s: tablo okunamadi veya ozet tutmuyor\n", dosya); temizle(); }
+        return ok;
+    }
+
+    int mesafe(int s, int t) const { return dist[(long long) s * V + t]; }
+
+    // s->t rotasini path'e yazar (s ve t dahil), yol yoksa 0. Bozuk tabloda (dongu, gecersiz
+    // dugum) V adimda t'ye varilamazsa da 0 doner; path en az V eleman tasir
+    int rota(int s, int t, int* path) const {
+        if (s < 0 || s >= V || t < 0 || t >= V || mesafe(s, t) == INT_MAX) return 0;
+        OLCUM_KAPSAM(Z_SORGU_ROTA);
+        int n = 0;
+        path[n++] = s;
+        for (int x = s; x != t; ) {
+            x = sonraki[(long long) x * V + t];
+            if (x < 0 || x >= V || n == V) return 0;
+            path[n++] = x;
+        }
+        return n;
+    }
+};
+
+// Daraltma hiyerarsisi (contraction hierarchy): duraklar onem sirasiyla tek tek daraltilir. Bir
+// durak cikarilirken komsulari arasindaki en kisa yol onun uzerinden geciyorsa (sinirli bir tanik
+// aramasi daha kisasini bulamazsa) yerine kisayol kenari eklenir. Sorgu iki yonlu dijkstra'dir ama
+// her taraf yalnizca sirasi yukselen kenarlari izler, bu yuzden uzak ciftlerde bile birkac yuz
+// dugum yerlesir. Kisayollar iki alt kenarini tasir; rota durak durak acilarak cikar.
+// --daralt ile kurulup dosyaya yazilir, --hiyerarsi ile yuklenir; canli guncelleme hiyerarsiyi birakir
+
+// Bir is parcacigina ait hiyerarsi sorgu tamponlari; mesafeler bir kez sonsuza kurulur, her sorgu
+// yalnizca dokundugu dugumleri geri alir
+struct HiyerarsiTamponu {
+    int V;
+    int* distF;
+    int* distB;
+    int* parF;            // ileri aramada dugume gelinen kenar
+    int* parB;
+    int* dokunulan;
+    int dokunulanN;
+    int* yigin;           // 2 * V: ileri agacin kenarlari ve kisayol acma yigini
+    OncelikKuyrugu* hF;
+    OncelikKuyrugu* hB;
+
+    HiyerarsiTamponu(): V(0), distF(nullptr), distB(nullptr), parF(nullptr), parB(nullptr), dokunulan(nullptr),
+                        dokunulanN(0), yigin(nullptr), hF(nullptr), hB(nullptr) {}
+    ~HiyerarsiTamponu() { birak(); }
+
+    void birak() {
+        std::free(distF); std::free(distB); std::free(parF); std::free(parB); std::free(dokunulan); std::free(yigin);
+        delete hF; delete hB;
+        distF = distB = parF = parB = dokunulan = yigin = nullptr;
+        hF = hB = nullptr;
+        V = 0;
+    }
+
+    void hazirla(int v) {
+        if (v == V) return;
+        birak();
+        V = v;
+        int n = V > 0 ? V : 1;
+        distF = (int*) std::malloc(sizeof(int) * n);
+        distB = (int*) std::malloc(sizeof(int) * n);
+        parF = (int*) std::malloc(sizeof(int) * n);
+        parB = (int*) std::malloc(sizeof(int) * n);
+        dokunulan = (int*) std::malloc(sizeof(int) * n);
+        yigin = (int*) std::malloc(sizeof(int) * 2 * n);
+        for (int i = 0; i < V; ++i) distF[i] = distB[i] = INT_MAX;
+        dokunulanN = 0;
+        hF = new OncelikKuyrugu(V);
+        hB = new OncelikKuyrugu(V);
+    }
+
+    void geriAl() {
+        for (int i = 0; i < dokunulanN; ++i) distF[dokunulan[i]] = distB[dokunulan[i]] = INT_MAX;
+        dokunulanN = 0;
+        hF->clear(); hB->clear();
+    }
+};
+
+class DaraltmaHiyerarsisi {
+private:
+    int V, K;
+    int* kKaynak;            // K kenar (asil + kisayol): uclar ve alt kenarlar (asil kenarda -1)
+    int* kHedef;
+    int* kAlt1;
+    int* kAlt2;
+    int* ileriOff;           // V+1: u'dan sirasi daha yuksek dugume giden kenarlar
+    int* ileriHedef;
+    int* ileriAgirlik;
+    int* ileriKenar;
+    int* geriOff;            // V+1: sirasi daha yuksek dugumden u'ya gelen kenarlar
+    int* geriKaynak;
+    int* geriAgirlik;
+    int* geriKenar;
+
+    struct DosyaBasligi {
+        char sihir[4];       // "ULCH"
+        int surum;
+        int V;
+        int E;
+        int K;
+        int ileriN;
+        int geriN;
+        unsigned toplam;     // dizilerin FNV-1a ozeti
+        unsigned agOzet;     // hiyerarsinin kuruldugu CSR'nin ozeti (Graph::csrOzet)
+    };
+
+    // Kurulum sirasindaki dinamik komsuluk girdisi
+    struct DKenar {
+        int komsu;
+        int kenar;
+        int agirlik;         // kenar dizisindekinin kopyasi (tanik aramasi dolayli okumasin)
+    };
+
+    // Kurulum durumu; kur() bitince atilir
+    struct Kurulum {
+        VecArr< VecArr<DKenar> > cikis, giris;     // yalnizca daraltilmamis komsular
+        VecArr<int> kaynak, hedef, agirlik, alt1, alt2;
+        int* tanik;          // tanik aramasi mesafeleri (INT_MAX = dokunulmadi)
+        char* hedefMi;       // tanik aramasinin hedefleri (haric'in cikis komsulari)
+        VecArr<int> tanikDokunulan;
+        char* daraltildi;
+        int* silinenKomsu;
+        OncelikKuyrugu* tanikHeap;
+    };
+
+    // tanik aramasinda en cok yerlesen dugum: oncelik tahmini icin kisa, gercek daraltmada uzun
+    // (kisa arama tanigi kacirirsa fazladan kisayol eklenir, sonuc yine dogrudur)
+    static const int TANIK_TAHMIN = 50;
+    static const int TANIK_SINIRI = 500;
+
+    static int* kopya(const VecArr<int>& v) {
+        int* c = (int*) std::malloc(sizeof(int) * (v.size() > 0 ? v.size() : 1));
+        if (v.size() > 0) std::memcpy(c, v.ptr(), sizeof(int) * v.size());
+        return c;
+    }
+
+    static int kenarEkle(Kurulum& k, int u, int v, int w, int a1, int a2) {
+        k.kaynak.pushLast(u); k.hedef.pushLast(v); k.agirlik.pushLast(w);
+        k.alt1.pushLast(a1); k.alt2.pushLast(a2);
+        return k.kaynak.size() - 1;
+    }
+
+    // u->v kenari yoksa ekler, varsa ve daha agirsa yenisiyle degistirir
+    static void kenarKoy(Kurulum& k, int u, int v, int w, int a1, int a2) {
+        VecArr<DKenar>& c = k.cikis[u];
+        for (int i = 0; i < c.size(); ++i) {
+            if (c[i].komsu != v) continue;
+            if (c[i].agirlik <= w) return;
+            int e = kenarEkle(k, u, v, w, a1, a2);
+            c[i].kenar = e; c[i].agirlik = w;
+            VecArr<DKenar>& g = k.giris[v];
+            for (int j = 0; j < g.size(); ++j) if (g[j].komsu == u) { g[j].kenar = e; g[j].agirlik = w; break; }
+            return;
+        }
+        int e = kenarEkle(k, u, v, w, a1, a2);
+        DKenar d; d.komsu = v; d.kenar = e; d.agirlik = w; c.pushLast(d);
+        d.komsu = u; k.giris[v].pushLast(d);
+    }
+
+    // haric'e ugramadan kaynaktan dijkstra; sinir'i asan ya da yerlesenSiniri'ndan sonrasi aranmaz,
+    // hedeflerin hepsi yerlesince de durur
+    static void tanikAra(Kurulum& k, int kaynak, int haric, int sinir, int yerlesenSiniri, int hedefSayisi) {
+        OncelikKuyrugu& h = *k.tanikHeap;
+        k.tanik[kaynak] = 0; k.tanikDokunulan.pushLast(kaynak);
+        h.insert(kaynak, 0);
+        int yerlesen = 0;
+        while (!h.isEmpty()) {
+            HeapN hn = h.extractMin();
+            if (hn.dist > sinir || ++yerlesen > yerlesenSiniri) break;
+            if (k.hedefMi[hn.vertex] && --hedefSayisi == 0) break;
+            const VecArr<DKenar>& c = k.cikis[hn.vertex];
+            for (int i = 0; i < c.size(); ++i) {
+                int v = c[i].komsu;
+                if (v == haric) continue;
+                int nd = hn.dist + c[i].agirlik;
+                if (nd < k.tanik[v]) {
+                    if (k.tanik[v] == INT_MAX) k.tanikDokunulan.pushLast(v);
+                    k.tanik[v] = nd;
+                    h.insertOrDecrease(v, nd);
+                }
+            }
+        }
+        h.clear();
+    }
+
+    static void tanikTemizle(Kurulum& k) {
+        for (int i = 0; i < k.tanikDokunulan.size(); ++i) k.tanik[k.tanikDokunulan[i]] = INT_MAX;
+        k.tanikDokunulan.clear();
+    }
+
+    // v daraltilirsa gereken kisayol sayisi; uygula ise kisayollari ekler
+    static int daralt(Kurulum& k, int v, bool uygula) {
+        int kisayol = 0;
+        const VecArr<DKenar>& gir = k.giris[v];
+        const VecArr<DKenar>& cik = k.cikis[v];
+        for (int i = 0; i < gir.size(); ++i) {
+            int u = gir[i].komsu, w1 = gir[i].agirlik;
+            int enCok = -1;
+            for (int j = 0; j < cik.size(); ++j)
+                if (cik[j].komsu != u && w1 + cik[j].agirlik > enCok) enCok = w1 + cik[j].agirlik;
+            if (enCok < 0) continue;
+            int hedef = 0;
+            for (int j = 0; j < cik.size(); ++j) if (cik[j].komsu != u) { k.hedefMi[cik[j].komsu] = 1; hedef++; }
+            tanikAra(k, u, v, enCok, uygula ? TANIK_SINIRI : TANIK_TAHMIN, hedef);
+            for (int j = 0; j < cik.size(); ++j) k.hedefMi[cik[j].komsu] = 0;
+            for (int j = 0; j < cik.size(); ++j) {
+                int x = cik[j].komsu;
+                if (x == u) continue;
+                int w = w1 + cik[j].agirlik;
+                if (k.tanik[x] <= w) continue;          // v'siz en az o kadar kisa yol var
+                kisayol++;
+                if (uygula) kenarKoy(k, u, x, w, gir[i].kenar, cik[j].kenar);
+            }
+            tanikTemizle(k);
+        }
+        return kisayol;
+    }
+
+    // Oncelik: kenar farki (eklenecek kisayol - silinecek kenar) + daraltilmis komsu sayisi
+    static int oncelik(Kurulum& k, int v) {
+        return daralt(k, v, false) - (k.giris[v].size() + k.cikis[v].size()) + k.silinenKomsu[v];
+    }
+
+    // Yardimci: v'yi komsusunun listesinden cikar
+    static void listedenSil(VecArr<DKenar>& l, int v) {
+        for (int i = 0; i < l.size(); ++i)
+            if (l[i].komsu == v) { l[i] = l[l.size() - 1]; l.popLast(); return; }
+    }
+
+    // kenar e'yi (kaynaktan hedefe) path'e acar: yalnizca ara ve hedef duraklar eklenir
+    int kenarAc(int e, int* path, int n, int* yigin) const {
+        int s = 0;
+        yigin[s++] = e;
+        while (s > 0) {
+            int x = yigin[--s];
+            if (kAlt1[x] == -1) { path[n++] = kHedef[x]; continue; }
+            yigin[s++] = kAlt2[x];
+            yigin[s++] = kAlt1[x];
+        }
+        return n;
+    }
+
+    unsigned dizilerOzeti(int ileriN, int geriN) const {
+        unsigned h = fnvOzet(kKaynak, sizeof(int) * (long long) K);
+        h = fnvOzet(kHedef, sizeof(int) * (long long) K, h);
+        h = fnvOzet(kAlt1, sizeof(int) * (long long) K, h);
+        h = fnvOzet(kAlt2, sizeof(int) * (long long) K, h);
+        h = fnvOzet(ileriOff, sizeof(int) * (long long) (V + 1), h);
+        h = fnvOzet(ileriHedef, sizeof(int) * (long long) ileriN, h);
+        h = fnvOzet(ileriAgirlik, sizeof(int) * (long long) ileriN, h);
+        h = fnvOzet(ileriKenar, sizeof(int) * (long long) ileriN, h);
+        h = fnvOzet(geriOff, sizeof(int) * (long long) (V + 1), h);
+        h = fnvOzet(geriKaynak, sizeof(int) * (long long) geriN, h);
+        h = fnvOzet(geriAgirlik, sizeof(int) * (long long) geriN, h);
+        return fnvOzet(geriKenar, sizeof(int) * (long long) geriN, h);
+    }
+
+public:
+    DaraltmaHiyerarsisi(): V(0), K(0), kKaynak(nullptr), kHedef(nullptr), kAlt1(nullptr), kAlt2(nullptr), ileriOff(nullptr), ileriHedef(nullptr),
+                           ileriAgirlik(nullptr), ileriKenar(nullptr), geriOff(nullptr), geriKaynak(nullptr),
+                           geriAgirlik(nullptr), geriKenar(nullptr) {}
+    ~DaraltmaHiyerarsisi() { temizle(); }
+
+    void temizle() {
+        std::free(kKaynak); std::free(kHedef); std::free(kAlt1); std::free(kAlt2);
+        std::free(ileriOff); std::free(ileriHedef); std::free(ileriAgirlik); std::free(ileriKenar);
+        std::free(geriOff); std::free(geriKaynak); std::free(geriAgirlik); std::free(geriKenar);
+        kKaynak = kHedef = kAlt1 = kAlt2 = ileriOff = ileriHedef = ileriAgirlik = ileriKenar = nullptr;
+        geriOff = geriKaynak = geriAgirlik = geriKenar = nullptr;
+        V = K = 0;
+    }
+
+    bool hazir() const { return ileriOff != nullptr; }
+    int vertexCount() const { return V; }
+    int kenarSayisi() const { return K; }
+    int yukariKenarSayisi() const { return hazir() ? ileriOff[V] + geriOff[V] : 0; }
+
+    // Dondurulmus graftan hiyerarsiyi kurar (paralel kenarlardan en hafifi, dondurulmus kapali
+    // durak kenarlari alinmaz); eklenen kisayol sayisini doner
+    int kur(const Graph& g) {
+        temizle();
+        V = g.vertexCount();
+        Kurulum k;
+        for (int u = 0; u < V; ++u) { k.cikis.pushLast(VecArr<DKenar>()); k.giris.pushLast(VecArr<DKenar>()); }
+        for (int u = 0; u < V; ++u)
+            for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e)
+                if (g.edgeDest(e) != u) kenarKoy(k, u, g.edgeDest(e), g.edgeWeight(e), -1, -1);
+        int asilK = k.kaynak.size();
+        int n = V > 0 ? V : 1;
+        k.tanik = (int*) std::malloc(sizeof(int) * n);
+        for (int i = 0; i < V; ++i) k.tanik[i] = INT_MAX;
+        k.daraltildi = (char*) std::calloc(n, 1);
+        k.hedefMi = (char*) std::calloc(n, 1);
+        k.silinenKomsu = (int*) std::calloc(n, sizeof(int));
+        k.tanikHeap = new OncelikKuyrugu(V);
+
+        OncelikKuyrugu sira(V);
+        for (int v = 0; v < V; ++v) sira.insert(v, oncelik(k, v));
+        VecArr<int> ileriN, geriN;                  // dugum basina yukari kenar sayisi, daraltma sirasinda
+        VecArr<int> ileriK, geriK;                  // kenar numaralari, dugume gore sonra dizilir
+        VecArr<int> ileriSahip, geriSahip;
+        VecArr<int> komsular;
+        while (!sira.isEmpty()) {
+            HeapN hn = sira.extractMin();
+            int v = hn.vertex;
+            int p = oncelik(k, v);
+            if (!sira.isEmpty() && p > sira.minDist()) { sira.insert(v, p); continue; }     // tembel guncelleme
+
+            // v'nin kalan kenarlari yukari kenarlardir
+            for (int i = 0; i < k.cikis[v].size(); ++i) { ileriK.pushLast(k.cikis[v][i].kenar); ileriSahip.pushLast(v); }
+            for (int i = 0; i < k.giris[v].size(); ++i) { geriK.pushLast(k.giris[v][i].kenar); geriSahip.pushLast(v); }
+            daralt(k, v, true);
+            k.daraltildi[v] = 1;
+            komsular.clear();
+            for (int i = 0; i < k.cikis[v].size(); ++i) { int x = k.cikis[v][i].komsu; listedenSil(k.giris[x], v); komsular.pushLast(x); }
+            for (int i = 0; i < k.giris[v].size(); ++i) { int u = k.giris[v][i].komsu; listedenSil(k.cikis[u], v); komsular.pushLast(u); }
+            k.cikis[v] = VecArr<DKenar>(); k.giris[v] = VecArr<DKenar>();
+            // komsularin onceligi yalnizca sayacla eskir; siradan ciktiklarinda yeniden hesaplanir
+            for (int i = 0; i < komsular.size(); ++i) if (!k.daraltildi[komsular[i]]) k.silinenKomsu[komsular[i]]++;
+        }
+
+        // kenar dizileri ve dugume gore yukari komsuluk (sayarak siralama)
+        K = k.kaynak.size();
+        kKaynak = kopya(k.kaynak); kHedef = kopya(k.hedef); kAlt1 = kopya(k.alt1); kAlt2 = kopya(k.alt2);
+        for (int yon = 0; yon < 2; ++yon) {
+            const VecArr<int>& kn = yon == 0 ? ileriK : geriK;
+            const VecArr<int>& sh = yon == 0 ? ileriSahip : geriSahip;
+            int m = kn.size();
+            int* off = (int*) std::calloc(V + 1, sizeof(int));
+            int* uc = (int*) std::malloc(sizeof(int) * (m > 0 ? m : 1));
+            int* w = (int*) std::malloc(sizeof(int) * (m > 0 ? m : 1));
+            int* ke = (int*) std::malloc(sizeof(int) * (m > 0 ? m : 1));
+            for (int i = 0; i < m; ++i) off[sh[i] + 1]++;
+            for (int u = 0; u < V; ++u) off[u + 1] += off[u];
+            int* yer = (int*) std::malloc(sizeof(int) * n);
+            for (int u = 0; u < V; ++u) yer[u] = off[u];
+            for (int i = 0; i < m; ++i) {
+                int j = yer[sh[i]]++, e = kn[i];
+                uc[j] = (yon == 0) ? k.hedef[e] : k.kaynak[e];
+                w[j] = k.agirlik[e];
+                ke[j] = e;
+            }
+            std::free(yer);
+            if (yon == 0) { ileriOff = off; ileriHedef = uc; ileriAgirlik = w; ileriKenar = ke; }
+            else { geriOff = off; geriKaynak = uc; geriAgirlik = w; geriKenar = ke; }
+        }
+        std::free(k.tanik); std::free(k.daraltildi); std::free(k.hedefMi); std::free(k.silinenKomsu);
+        delete k.tanikHeap;
+        return K - asilK;
+    }
+
+    bool kaydet(const char* dosya, const Graph& g) const {
+        FILE* f = std::fopen(dosya, "wb");
+        if (!f) { std::perror(dosya); return false; }
+        int ileriN = ileriOff[V], geriN = geriOff[V];
+        DosyaBasligi b;
+        std::memcpy(b.sihir, "ULCH", 4);
+        b.surum = 2; b.V = V; b.E = g.edgeCount(); b.K = K; b.ileriN = ileriN; b.geriN = geriN;
+        b.toplam = dizilerOzeti(ileriN, geriN);
+        b.agOzet = g.csrOzet();
+        const int* diziler[12] = { kKaynak, kHedef, kAlt1, kAlt2, ileriOff, ileriHedef, ileriAgirlik, ileriKenar,
+                                   geriOff, geriKaynak, geriAgirlik, geriKenar };
+        const int boy[12] = { K, K, K, K, V + 1, ileriN, ileriN, ileriN, V + 1, geriN, geriN, geriN };
+        bool ok = std::fwrite(&b, sizeof(b), 1, f) == 1;
+        for (int i = 0; i < 12 && ok; ++i) ok = (int) std::fwrite(diziler[i], sizeof(int), boy[i], f) == boy[i];
+        std::fclose(f);
+        return ok;
+    }
+
+    // Hiyerarsi mevcut grafla (V, E, kenar agirliklari) eslesmiyorsa, boyutu basliga uymuyorsa
+    // veya bozuksa yuklenmez
+    bool yukle(const char* dosya, const Graph& g) {
+        FILE* f = std::fopen(dosya, "rb");
+        if (!f) { std::perror(dosya); return false; }
+        struct stat st;
+        DosyaBasligi b;
+        if (::fstat(::fileno(f), &st) != 0 || std::fread(&b, sizeof(b), 1, f) != 1 || std::memcmp(b.sihir, "ULCH", 4) != 0
+            || b.surum != 2 || b.V < 0 || b.K < 0 || b.ileriN < 0 || b.geriN < 0) {
+            std::fprintf(stderr, "%s: gecersiz veya eski surum hiyerarsi dosyasi (--daralt ile yeniden olusturun)\n", dosya);
+            std::fclose(f); return false;
+        }
+        if (b.V != g.vertexCount() || b.E != g.edgeCount() || b.agOzet != g.csrOzet()) {
+            std::fprintf(stderr, "%s: hiyerarsi bu aga ait degil (V=%d E=%d, beklenen V=%d E=%d%s)\n", dosya, b.V, b.E,
+                         g.vertexCount(), g.edgeCount(), b.agOzet != g.csrOzet() ? ", kenarlar farkli" : "");
+            std::fclose(f); return false;
+        }
+        long long beklenenBoyut = (long long) sizeof(b) + (long long) sizeof(int)
+                                * (4LL * b.K + 2LL * (b.V + 1) + 3LL * b.ileriN + 3LL * b.geriN);
+        if ((long long) st.st_size != beklenenBoyut) {
+            std::fprintf(stderr, "%s: dosya boyutu basliga uymuyor (%lld, beklenen %lld)\n", dosya, (long long) st.st_size, beklenenBoyut);
+            std::fclose(f); return false;
+        }
+        temizle();
+        V = b.V; K = b.K;
+        int** diziler[12] = { &kKaynak, &kHedef, &kAlt1, &kAlt2, &ileriOff, &ileriHedef, &ileriAgirlik, &ileriKenar,
+                              &geriOff, &geriKaynak, &geriAgirlik, &geriKenar };
+        const int boy[12] = { K, K, K, K, V + 1, b.ileriN, b.ileriN, b.ileriN, V + 1, b.geriN, b.geriN, b.geriN };
+        bool ok = true;
+        for (int i = 0; i < 12; ++i) {
+            *diziler[i] = (int*) std::malloc(sizeof(int) * (boy[i] > 0 ? boy[i] : 1));
+            if (ok) ok = (int) std::fread(*diziler[i], sizeof(int), boy[i], f) == boy[i];
+        }
+        ok = ok && ileriOff[V] == b.ileriN && geriOff[V] == b.geriN && dizilerOzeti(b.ileriN, b.geriN) == b.toplam;
+        std::fclose(f);
+        if (!ok) { std::fprintf(stderr, "%s: hiyerarsi okunamadi veya ozet tutmuyor\n", dosya); temizle(); }
+        return ok;
+    }
+
+    // s->t en kisa rotasini durak durak path'e yazar, uzunlugu doner (yol yoksa 0); settled iki
+    // taraftaki toplam. Taraflar kucuk anahtarli olandan ilerler, anahtari en iyi bulusmayi gecen durur
+    int rota(int s, int t, HiyerarsiTamponu& b, int* path, int& settled) const {
+        settled = 0;
+        if (s < 0 || s >= V || t < 0 || t >= V) return 0;
+        if (s == t) { path[0] = s; return 1; }
+        b.hazirla(V);
+        OncelikKuyrugu& hF = *b.hF;
+        OncelikKuyrugu& hB = *b.hB;
+        b.distF[s] = 0; b.parF[s] = -1; b.dokunulan[b.dokunulanN++] = s; hF.insert(s, 0);
+        b.distB[t] = 0; b.parB[t] = -1; b.dokunulan[b.dokunulanN++] = t; hB.insert(t, 0);
+        int mu = INT_MAX, bulusma = -1;
+        while (true) {
+            bool ileriVar = !hF.isEmpty() && hF.minDist() < mu;
+            bool geriVar = !hB.isEmpty() && hB.minDist() < mu;
+            if (!ileriVar && !geriVar) break;
+            bool ileri = ileriVar && (!geriVar || hF.minDist() <= hB.minDist());
+            OncelikKuyrugu& h = ileri ? hF : hB;
+            int* d = ileri ? b.distF : b.distB;
+            int* par = ileri ? b.parF : b.parB;
+            const int* karsi = ileri ? b.distB : b.distF;
+            const int* off = ileri ? ileriOff : geriOff;
+            const int* uc = ileri ? ileriHedef : geriKaynak;
+            const int* w = ileri ? ileriAgirlik : geriAgirlik;
+            const int* ke = ileri ? ileriKenar : geriKenar;
+            HeapN hn = h.extractMin();
+            int u = hn.vertex, du = hn.dist;
+            settled++;
+            if (karsi[u] != INT_MAX && du + karsi[u] < mu) { mu = du + karsi[u]; bulusma = u; }
+            OLCUM_SAY(S_YERLESEN, 1); OLCUM_SAY(S_GEVSETME, off[u + 1] - off[u]);
+            for (int i = off[u]; i < off[u + 1]; ++i) {
+                int v = uc[i], nd = du + w[i];
+                if (nd >= d[v]) continue;
+                if (b.distF[v] == INT_MAX && b.distB[v] == INT_MAX) b.dokunulan[b.dokunulanN++] = v;
+                d[v] = nd; par[v] = ke[i];
+                h.insertOrDecrease(v, nd);
+            }
+        }
+        int n = 0;
+        if (bulusma != -1) {
+            OLCUM_KAPSAM(Z_SORGU_ROTA);
+            // s..bulusma: ileri agactaki kenarlar tersten toplanip sirayla acilir
+            int m = 0;
+            for (int x = bulusma; b.parF[x] != -1; x = kKaynak[b.parF[x]]) b.yigin[m++] = b.parF[x];
+            path[n++] = s;
+            int* yigin = b.yigin + m;
+            for (int i = m - 1; i >= 0; --i) n = kenarAc(b.yigin[i], path, n, yigin);
+            // bulusma..t: geri agactaki kenarlar zaten bulusmadan t'ye siralidir
+            for (int x = bulusma; b.parB[x] != -1; ) {
+                int e = b.parB[x];
+                n = kenarAc(e, path, n, b.yigin);
+                x = kHedef[e];
+            }
+        }
+        b.geriAl();
+        return n;
+    }
+};
+
+static DaraltmaHiyerarsisi hiyerarsi;    // --hiyerarsi ile yuklenirse rotalar buradan cikar
+
+// Aktarma duyarli yonlendirme: durum = (durak, hat). Her durakta slot 0 "Yok" (hatsiz kenar),
+// diger slotlar o duraga degen kenarlarin hatlari. Ayni hatta devam etmek kenar agirligina,
+// hat degistirmek ek olarak aktarma cezasina mal olur. Hat listeleri grafOlustur'un
+// addLineToEdge ile kenarlara ekledigi listelerden alinir.
+class AktarmaMotoru {
+private:
+    int V, S;                // S = durum sayisi; S numarali durum sanal baslangic
+    int* durumOff;           // V+1
+    int* durumDurak;         // S
+    int* durumHat;           // S, hat numarasi (-1 = Yok)
+    int* girisOff;           // E+1: e kenarinin gecis girdileri [girisOff[e], girisOff[e+1])
+    int* girisHedef;         // hedef durum
+    int* girisHat;           // gecisin hatti (-1 = Yok)
+
+public:
+    AktarmaMotoru(): V(0), S(0), durumOff(nullptr), durumDurak(nullptr), durumHat(nullptr),
+                     girisOff(nullptr), girisHedef(nullptr), girisHat(nullptr) {}
+    ~AktarmaMotoru() { temizle(); }
+
+    void temizle() {
+        std::free(durumOff); std::free(durumDurak); std::free(durumHat);
+        std::free(girisOff); std::free(girisHedef); std::free(girisHat);
+        durumOff = durumDurak = durumHat = girisOff = girisHedef = girisHat = nullptr;
+        V = S = 0;
+    }
+
+    bool hazir() const { return durumOff != nullptr; }
+    int durumSayisi() const { return S; }
+
+    // Dondurulmus (CSR) graftan durum uzayini kurar
+    void kur(const Graph& g) {
+        temizle();
+        V = g.vertexCount();
+        int E = g.edgeCount();
+        VecArr< VecArr<int> > hatKume;
+        for (int u = 0; u < V; ++u) { VecArr<int> k; k.pushLast(-1); hatKume.pushLast(k); }
+        for (int u = 0; u < V; ++u) {
+            for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+                int v = g.edgeDest(e);
+                if (v == u) continue;       // kapali duraga giden (dondurulmus) kenar
+                for (const int* hp = g.edgeLinesBegin(e); hp != g.edgeLinesEnd(e); ++hp) {
+                    hatKume[u].pushLast(*hp);
+                    hatKume[v].pushLast(*hp);
+                }
+            }
+        }
+        // her durakta sirala ve tekrarlari at (Yok = -1 hep slot 0'da kalir)
+        durumOff = (int*) std::malloc(sizeof(int) * (V + 1));
+        S = 0;
+        for (int u = 0; u < V; ++u) {
+            VecArr<int>& k = hatKume[u];
+            for (int i = 1; i < k.size(); ++i) {
+                int x = k[i], j = i - 1;
+                while (j >= 0 && k[j] > x) { k[j + 1] = k[j]; --j; }
+                k[j + 1] = x;
+            }
+            int m = 0;
+            for (int i = 0; i < k.size(); ++i) if (m == 0 || k[m - 1] != k[i]) k[m++] = k[i];
+            while (k.size() > m) k.popLast();
+            durumOff[u] = S;
+            S += m;
+        }
+        durumOff[V] = S;
+        durumDurak = (int*) std::malloc(sizeof(int) * (S > 0 ? S : 1));
+        durumHat = (int*) std::malloc(sizeof(int) * (S > 0 ? S : 1));
+        for (int u = 0; u < V; ++u)
+            for (int i = 0; i < hatKume[u].size(); ++i) {
+                durumDurak[durumOff[u] + i] = u;
+                durumHat[durumOff[u] + i] = hatKume[u][i];
+            }
+
+        int girdi = 0;
+        for (int e = 0; e < E; ++e) {
+            int n = (int) (g.edgeLinesEnd(e) - g.edgeLinesBegin(e));
+            girdi += (n > 0) ? n : 1;
+        }
+        girisOff = (int*) std::malloc(sizeof(int) * (E + 1));
+        girisHedef = (int*) std::malloc(sizeof(int) * (girdi > 0 ? girdi : 1));
+        girisHat = (int*) std::malloc(sizeof(int) * (girdi > 0 ? girdi : 1));
+        int k = 0;
+        for (int u = 0; u < V; ++u) {
+            for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+                int v = g.edgeDest(e);
+                girisOff[e] = k;
+                if (v == u) continue;
+                if (g.edgeLinesBegin(e) == g.edgeLinesEnd(e)) {
+                    girisHedef[k] = durumOff[v]; girisHat[k] = -1; k++;
+                    continue;
+                }
+                for (const int* hp = g.edgeLinesBegin(e); hp != g.edgeLinesEnd(e); ++hp) {
+                    int lo = durumOff[v], hi = durumOff[v + 1] - 1;
+                    while (lo < hi) {
+                        int mid = (lo + hi) / 2;
+                        if (durumHat[mid] < *hp) lo = mid + 1; else hi = mid;
+                    }
+                    girisHedef[k] = lo; girisHat[k] = *hp; k++;
+                }
+            }
+        }
+        girisOff[E] = k;
+    }
+
+    // src'den tum durumlara (mesafe + ceza * aktarma) en kucuk maliyet agaci.
+    // dDist/dParent en az S+1 boyunda olmali
+    void agacKur(const Graph& g, int src, int ceza, int* dDist, int* dParent) const {
+        for (int i = 0; i <= S; ++i) { dDist[i] = INT_MAX; dParent[i] = -1; }
+        dDist[S] = 0;
+        OncelikKuyrugu pq(S + 1);
+        pq.insert(S, 0);
+        while (!pq.isEmpty()) {
+            HeapN hn = pq.extractMin();
+            int s = hn.vertex;
+            int ds = hn.dist;
+            int u = (s == S) ? src : durumDurak[s];
+            OLCUM_SAY(S_YERLESEN, 1);
+            for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+                int w = g.edgeWeight(e);
+                OLCUM_SAY(S_GEVSETME, girisOff[e + 1] - girisOff[e]);
+                for (int k = girisOff[e]; k < girisOff[e + 1]; ++k) {
+                    int c = ds + w;
+                    if (s != S && girisHat[k] != durumHat[s]) c += ceza;
+                    int t = girisHedef[k];
+                    if (c < dDist[t]) {
+                        pq.insertOrDecrease(t, c);
+                        dDist[t] = c;
+                        dParent[t] = s;
+                    }
+                }
+            }
+        }
+    }
+
+    // agacKur sonrasi dst'ye en ucuz rotayi duraklar (path) ve bolum hatlari (hatlar[i]: path[i]->path[i+1]) olarak cikarir
+    int rotaCikar(int src, int dst, const int* dDist, const int* dParent, int* path, int* hatlar) const {
+        OLCUM_KAPSAM(Z_SORGU_ROTA);
+        if (src == dst) { path[0] = src; return 1; }
+        int enIyi = -1;
+        for (int s = durumOff[dst]; s < durumOff[dst + 1]; ++s)
+            if (dDist[s] != INT_MAX && (enIyi == -1 || dDist[s] < dDist[enIyi])) enIyi = s;
+        if (enIyi == -1) return 0;
+        int n = 0;
+        for (int s = enIyi; s != S; s = dParent[s]) {
+            path[n] = durumDurak[s];
+            hatlar[n] = durumHat[s];
+            n++;
+        }
+        path[n++] = src;
+        // ters cevir: path kaynaktan hedefe, hatlar[i] = path[i]->path[i+1] bolumunun hatti
+        for (int i = 0; i < n / 2; ++i) { int t = path[i]; path[i] = path[n - 1 - i]; path[n - 1 - i] = t; }
+        for (int i = 0; i < (n - 1) / 2; ++i) { int t = hatlar[i]; hatlar[i] = hatlar[n - 2 - i]; hatlar[n - 2 - i] = t; }
+        return n;
+    }
+};
+
+// Satirin bir alani: dosyanin icini gosterir, '\0' ile bitmez
+struct Alan {
+    const char* p;
+    int n;
+
+    bool esit(const char* s) const { return (int) std::strlen(s) == n && std::memcmp(p, s, n) == 0; }
+
+    // atoi gibi: isaret ve bastaki rakamlar okunur, gerisi yok sayilir
+    int tamsayi() const {
+        int i = 0; bool eksi = false;
+        if (i < n && (p[i] == '-' || p[i] == '+')) { eksi = (p[i] == '-'); ++i; }
+        long long x = 0;
+        for (; i < n && p[i] >= '0' && p[i] <= '9' && x <= INT_MAX; ++i) x = x * 10 + (p[i] - '0');
+        return (int) (eksi ? -x : x);
+    }
+
+    // en fazla boyut-1 karakteri hedefe kopyalar ve '\0' ile bitirir
+    void kopyala(char* hedef, int boyut) const {
+        int k = n < boyut - 1 ? n : boyut - 1;
+        std::memcpy(hedef, p, k);
+        hedef[k] = '\0';
+    }
+};
+
+// Tum metin yukleyicilerinin ortak CSV okuyucusu. Dosya mmap'lenir; satirlar ve virgulle
+// ayrilmis alanlar kopyalanmadan, bastaki/sondaki bosluklar atilmis olarak Alan seklinde verilir.
+// Satir uzunlugu sinirsizdir, okuma sirasinda bellek ayrilmaz
+class CsvOkuyucu {
+private:
+    const char* taban;
+    long long boyut;
+    const char* imlec;       // sonraki satirin basi
+    const char* satirBas;
+    const char* satirSon;    // '\n' veya dosya sonu
+    const char* alanImlec;   // gecerli satirda sonraki alanin basi
+    bool alanKaldi;
+    bool sahip;              // false: baglan() ile verilen aralik, eslemeyi kaldirmaz
+
+    static bool bosluk(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+public:
+    CsvOkuyucu(): taban(nullptr), boyut(0), imlec(nullptr), satirBas(nullptr), satirSon(nullptr), alanImlec(nullptr), alanKaldi(false), sahip(true) {}
+    ~CsvOkuyucu() { kapat(); }
+    CsvOkuyucu(const CsvOkuyucu&) = delete;
+    CsvOkuyucu& operator=(const CsvOkuyucu&) = delete;
+
+    // Acilamazsa false (errno korunur, cagiran perror ile bildirir)
+    bool ac(const char* dosya) {
+        kapat();
+        int fd = ::open(dosya, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0) { ::close(fd); return false; }
+        if (st.st_size > 0) {
+            void* h = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (h == MAP_FAILED) { ::close(fd); return false; }
+            ::madvise(h, st.st_size, MADV_SEQUENTIAL);
+            taban = (const char*) h;
+            boyut = st.st_size;
+        }
+        ::close(fd);
+        imlec = taban;
+        return true;
+    }
+
+    void kapat() {
+        if (taban && sahip) ::munmap((void*) taban, boyut);
+        taban = imlec = satirBas = satirSon = alanImlec = nullptr;
+        boyut = 0; alanKaldi = false; sahip = true;
+    }
+
+    // Baska bir okuyucunun eslemesindeki [p, p+n) araligini okur (paralel yukleyicinin parcalari)
+    void baglan(const char* p, long long n) {
+        kapat();
+        taban = imlec = p; boyut = n; sahip = false;
+    }
+
+    long long bayt() const { return boyut; }
+    const char* veri() const { return taban; }
+    long long satirKonumu() const { return satirBas - taban; }   // gecerli satirin bayt ofseti
+    const char* satirBasi() const { return satirBas; }
+    const char* satirSonu() const { return satirSon; }
+    void bastan() { imlec = taban; alanKaldi = false; }
+    const char* kalanBas() const { return imlec; }
+    const char* sonu() const { return taban + boyut; }
+
+    // Sonraki satira gecer; dosya sonunda false
+    bool satir() {
+        const char* son = taban + boyut;
+        if (!taban || imlec >= son) { alanKaldi = false; return false; }
+        const char* nl = (const char*) std::memchr(imlec, '\n', son - imlec);
+        satirBas = alanImlec = imlec;
+        satirSon = nl ? nl : son;
+        imlec = nl ? nl + 1 : son;
+        alanKaldi = true;
+        return true;
+    }
+
+    // Gecerli satir yalnizca bosluklardan mi olusuyor
+    bool bosSatir() const {
+        for (const char* c = satirBas; c < satirSon; ++c) if (!bosluk(*c)) return false;
+        return true;
+    }
+
+    // Gecerli satirin alanlarini yeniden bastan verir
+    void satirBasinaDon() { if (satirBas) { alanImlec = satirBas; alanKaldi = true; } }
+
+    // Gecerli satirin sonraki alani; satirda alan kalmadiysa false. Bos alanlar atlanmaz
+    bool alan(Alan& a) {
+        if (!alanKaldi) return false;
+        const char* virgul = (const char*) std::memchr(alanImlec, ',', satirSon - alanImlec);
+        const char* b = alanImlec;
+        const char* e = virgul ? virgul : satirSon;
+        if (virgul) alanImlec = virgul + 1; else alanKaldi = false;
+        while (b < e && bosluk(*b)) ++b;
+        while (e > b && bosluk(e[-1])) --e;
+        a.p = b; a.n = (int) (e - b);
+        return true;
+    }
+};
+
+// Durak isimleri tek karakter havuzunda tutulur (interned); isim -> ID icin
+// lineer sondalamali acik adresli hash indeksi yukleme sirasinda kurulur
+class IsimTablosu {
+private:
+    VecArr<char> havuz;
+    VecArr<int> isimOff;     // id -> havuz offseti, -1 = tanimsiz
+    int* tablo;              // slot -> id, 0 = bos
+    int tabloCap;            // 2'nin kuvveti
+    int adet;
+    // anlik goruntuden yuklendiyse havuz, offsetler ve tablo dosyanin icini gosterir (salt okunur)
+    const char* gHavuz;
+    int gHavuzN;
+    const int* gOff;
+    int gOffN;
+    bool yenidenKur;         // ayni ID tekrar eklendi; tablo tamamla()'da bastan kurulur
+
+    const char* havuzP() const { return gHavuz ? gHavuz : havuz.ptr(); }
+    const int* offP() const { return gHavuz ? gOff : isimOff.ptr(); }
+    int offN() const { return gHavuz ? gOffN : isimOff.size(); }
+
+    static unsigned hashle(const char* s, int n) {
+        unsigned h = 2166136261u;    // FNV-1a
+        for (int i = 0; i < n; ++i) { h ^= (unsigned char) s[i]; h *= 16777619u; }
+        return h;
+    }
+
+    bool esit(int id, const char* s, int n) const {
+        const char* a = &havuzP()[offP()[id]];
+        return std::strncmp(a, s, n) == 0 && a[n] == '\0';
+    }
+
+    void tabloyaKoy(int id) {
+        const char* a = &havuzP()[offP()[id]];
+        int n = std::strlen(a);
+        unsigned mask = tabloCap - 1;
+        for (unsigned i = hashle(a, n) & mask; ; i = (i + 1) & mask) {
+            if (tablo[i] == 0) { tablo[i] = id; return; }
+            // ayni isimde iki durak varsa eski davranis gibi kucuk ID kazanir
+            if (esit(tablo[i], a, n)) { if (id < tablo[i]) tablo[i] = id; return; }
+        }
+    }
+
+    void buyut() {
+        int eskiCap = tabloCap; int* eski = tablo;
+        tabloCap = (tabloCap == 0) ? 64 : tabloCap * 2;
+        tablo = (int*) std::calloc(tabloCap, sizeof(int));
+        for (int i = 0; i < eskiCap; ++i) if (eski[i]) tabloyaKoy(eski[i]);
+        std::free(eski);
+    }
+
+public:
+    IsimTablosu(): tablo(nullptr), tabloCap(0), adet(0), gHavuz(nullptr), gHavuzN(0), gOff(nullptr), gOffN(0), yenidenKur(false) {}
+    ~IsimTablosu() { if (!gHavuz) std::free(tablo); }
+
+    void temizle() {
+        if (!gHavuz) std::free(tablo);
+        tablo = nullptr; tabloCap = 0; adet = 0;
+        gHavuz = nullptr; gHavuzN = 0; gOff = nullptr; gOffN = 0;
+        yenidenKur = false;
+        havuz.clear(); isimOff.clear();
+    }
+
+    void anlikYaz(AnlikYazici& y) const {
+        y.dizi(havuzP(), gHavuz ? gHavuzN : havuz.size());
+        y.dizi(offP(), offN());
+        y.dizi(tablo, tabloCap);
+        y.dizi(&adet, 1);
+    }
+
+    bool anlikBagla(AnlikOkuyucu& o) {
+        int nHavuz, nOff, nTablo, nAdet;
+        const char* h = o.dizi<char>(nHavuz);
+        const int* off = o.dizi<int>(nOff);
+        const int* t = o.dizi<int>(nTablo);
+        const int* a = o.dizi<int>(nAdet);
+        if (!o.ok || nAdet != 1 || nTablo < 1 || (nTablo & (nTablo - 1)) != 0) return false;
+        if (!gHavuz) std::free(tablo);
+        havuz.clear(); isimOff.clear();
+        gHavuz = h; gHavuzN = nHavuz; gOff = off; gOffN = nOff;
+        tablo = const_cast<int*>(t); tabloCap = nTablo; adet = *a;
+        return true;
+    }
+
+    // ad n karakter, '\0' ile bitmesi gerekmez. Ayni ID tekrar gelirse eski durak dizisi gibi son
+    // ad gecerli olur; isim indeksi tamamla() cagrilinca bastan kurulur
+    void ekle(int id, const char* ad, int n) {
+        if (id < 1) return;
+        while (isimOff.size() <= id) isimOff.pushLast(-1);
+        bool tekrar = isimOff[id] >= 0;
+        isimOff[id] = havuz.size();
+        for (int i = 0; i < n; ++i) havuz.pushLast(ad[i]);
+        havuz.pushLast('\0');
+        if (tekrar) { yenidenKur = true; return; }
+        if ((adet + 1) * 2 > tabloCap) buyut();
+        tabloyaKoy(id);
+        adet++;
+    }
+
+    // Eklemeler bitti: tekrarlanan ID varsa isim indeksini gecerli adlardan yeniden kurar
+    void tamamla() {
+        if (!yenidenKur) return;
+        yenidenKur = false;
+        for (int i = 0; i < tabloCap; ++i) tablo[i] = 0;
+        for (int id = 1; id < isimOff.size(); ++id) if (isimOff[id] >= 0) tabloyaKoy(id);
+    }
+
+    // isim (uzunluk n, '\0' ile bitmesi gerekmez) -> id, yoksa -1
+    int bul(const char* s, int n) const {
+        if (tabloCap == 0) return -1;
+        unsigned mask = tabloCap - 1;
+        for (unsigned i = hashle(s, n) & mask; tablo[i] != 0; i = (i + 1) & mask)
+            if (esit(tablo[i], s, n)) return tablo[i];
+        return -1;
+    }
+    int bul(const char* s) const { return bul(s, std::strlen(s)); }
+
+    // tanimsiz ID icin nullptr
+    const char* ad(int id) const {
+        if (id < 1 || id >= offN() || offP()[id] < 0) return nullptr;
+        return &havuzP()[offP()[id]];
+    }
+};
+
+// Global Degiskenler (boyutlar girdi dosyalarindan calisma zamaninda belirlenir)
+static int durakSayisi = 0;              // en buyuk durak ID'si
+// durak_listesi.txt'de kabul edilen en buyuk ID: DURAK_ID_KATSAYI * satir sayisi + DURAK_ID_PAYI
+static const long long DURAK_ID_KATSAYI = 4;
+static const long long DURAK_ID_PAYI = 1024;
+static IsimTablosu durakIsimleri;       // durakID <-> isim
+static VecArr<int> hatNoArr;
+static VecArr<char*> hatNameArr;
+static int hatSayisi = 0;
+static VecArr< VecArr<int> > hatDuraklari;
+static VecArr< VecArr<char*> > hatDurakAdlari;
+
+static DurakHatIndeksi durakHatIndeksi;
+static MesafeTablosu mesafeTablosu;      // --tablo ile yuklenirse rotalar buradan cikar
+static AktarmaMotoru aktarmaMotoru;
+static int aktarmaCezasi = -1;           // >= 0 ise rotalar aktarma duyarli motordan cikar
+static bool arenaAcik = true;            // --arenasiz: dugumler tek tek new ile ayrilir
+static int yuklemeIscisi = 1;            // --yukleme-iscisi: mesafe dosyasini ayristiran is parcacigi sayisi
+static bool kenarListesiZorla = false;   // --kenar-listesi: mesafe dosyasi basliksiz kenar listesi
+
+class Graph;
+Graph globalGraph(0);
+
+// Yardimci: durak ismi (listede olmayan ID icin bos)
+static const char* durakAdi(int id) {
+    const char* ad = durakIsimleri.ad(id);
+    return ad ? ad : "";
+}
+
+// Yardimci: kirpilmis token'in kopyasini ayir
+static char* strKopya(const char* s, int n) {
+    char* c = (char*) std::malloc(n + 1);
+    std::memcpy(c, s, n);
+    c[n] = '\0';
+    return c;
+}
+static char* strKopya(const char* s) { return strKopya(s, std::strlen(s)); }
+
+// Yardimci: Durak ismine gore id bul
+int findDurakIDbyName(const char* name) {
+    return durakIsimleri.bul(name);
+}
+
+// Eski dogrusal strcmp taramasi; yalnizca olcum karsilastirmasi icin
+static int findDurakIDbyNameLineer(const char* name) {
+    for (int i = 1; i <= durakSayisi; ++i) {
+        const char* ad = durakIsimleri.ad(i);
+        if (ad && std::strcmp(ad, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Fonksiyonlar 
+void grafOlustur(const char* durakListF, const char* hatlarF, const char* mesafeF, Graph& g);
+void durakAra(int durakID, FILE* out = stdout);
+void yolcuPlanla(const char* yolcuFile, int arananYolcuID);
+void yolcuTopluPlanla(const char* yolcuFile, const char* ciktiFile);
+void tumHatlariListele(FILE* out = stdout);
+void hatDuraklariGoster(int hatNo, FILE* out = stdout);
+
+// Yardimci: gecerli satir kenar listesi basligi "u,v,..." mi (alanlar bastan okunacak sekilde birakilir)
+static bool kenarListesiBasligi(CsvOkuyucu& csv) {
+    Alan a, b;
+    bool baslik = csv.alan(a) && csv.alan(b) && a.esit("u") && b.esit("v");
+    csv.satirBasinaDon();
+    return baslik;
+}
+
+// Mesafe dosyasinin bicimi:
+//   yogun matris : satir u, sutun v, "-" = kenar yok; dosya V*V hucre
+//   kenar listesi: "u,v,mesafe" basligi, sonra her satirda bir kenar (durak ID'leri); dosya O(E)
+// Kenar listesi basligindan taninir, --kenar-listesi ile basliksiz dosya da kenar listesi sayilir.
+// Okuyucu baslik varsa ondan sonraya, yoksa dosya basina konumlanir; kenar listesiyse true
+static bool mesafeBicimiBelirle(CsvOkuyucu& csv) {
+    bool baslik = csv.satir() && kenarListesiBasligi(csv);
+    if (!baslik) csv.bastan();
+    return kenarListesiZorla || baslik;
+}
+
+// Yogun matris satirinin vektorel ayristiricisi. Virguller 32 (AVX2) / 16 (SSE2) baytlik bloklar
+// halinde tek karsilastirmayla bit maskesine cevrilir, alan sinirlari maskeden okunur. Kirpilmis
+// alan en fazla 8 rakamsa deger 8 baytlik tek yuklemeyle SWAR olarak cevrilir; isaretli, daha
+// uzun ya da okunabilir alanin sonuna 8 bayttan yakin alanlar Alan::tamsayi'ya duser. SIMD
+// yoksa virguller memchr ile bulunur. Her yolda sonuc alan() + tamsayi() dongusuyle aynidir
+#if defined(__AVX2__)
+static const char* const MATRIS_SIMD = "AVX2";
+#elif defined(__SSE2__)
+static const char* const MATRIS_SIMD = "SSE2";
+#else
+static const char* const MATRIS_SIMD = "skaler";
+#endif
+
+static inline bool matrisBosluk(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+// Yardimci: p'deki n (1..8) karakterin hepsi rakamsa degeri yazar; p'den itibaren 8 bayt okunabilmeli
+static inline bool sekizRakamCevir(const char* p, int n, int& deger) {
+    uint64_t x;
+    std::memcpy(&x, p, 8);
+    uint64_t maske = n == 8 ? ~0ULL : (1ULL << (8 * n)) - 1;
+    x &= maske;
+    // her baytta '0'..'9' disi bir deger isaret bitini yakar
+    if ((((x + 0x4646464646464646ULL) | (x - 0x3030303030303030ULL)) & 0x8080808080808080ULL & maske) != 0) return false;
+    x = (x - (0x3030303030303030ULL & maske)) << (8 * (8 - n));      // eksik basamaklar bastaki sifir olur
+    x = x * 10 + (x >> 8);
+    x = (((x & 0x000000FF000000FFULL) * 0x000F424000000064ULL) + (((x >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >> 32;
+    deger = (int) (uint32_t) x;
+    return true;
+}
+
+template<typename F>
+static inline void matrisHucresi(const char* b, const char* e, const char* okunabilirSon, int row, int col, F& kenar) {
+    while (b < e && matrisBosluk(*b)) ++b;
+    while (e > b && matrisBosluk(e[-1])) --e;
+    int n = (int) (e - b);
+    if (n == 0 || (n == 1 && *b == '-')) return;
+    int w;
+    if (n > 8 || okunabilirSon - b < 8 || !sekizRakamCevir(b, n, w)) {
+        Alan a; a.p = b; a.n = n;
+        w = a.tamsayi();
+    }
+    kenar(row, col, w);
+}
+
+// Yardimci: blok maskelerini isler (bit i = p[i]). Seyrek matrislerde bloklarin cogu yalnizca
+// "-" ve virgulden olusur; yan yana iki '-' yoksa ilk virgulden sonraki hucreler "-" ya da bostur,
+// yalnizca ilk virgulun kapattigi hucre ayristirilir, digerleri sayilip atlanir
+template<typename F>
+static inline void matrisBlogu(const char* p, unsigned virgul, unsigned tire, unsigned diger,
+                               const char*& alanBas, int& col, const char* okunabilirSon, int row, F& kenar) {
+    if (virgul == 0) return;
+    if (diger == 0 && (tire & (tire >> 1)) == 0) {
+        const char* v = p + __builtin_ctz(virgul);
+        matrisHucresi(alanBas, v, okunabilirSon, row, col, kenar);
+        col += __builtin_popcount(virgul);
+        alanBas = p + (31 - __builtin_clz(virgul)) + 1;
+        return;
+    }
+    for (; virgul; virgul &= virgul - 1) {
+        const char* v = p + __builtin_ctz(virgul);
+        matrisHucresi(alanBas, v, okunabilirSon, row, col++, kenar);
+        alanBas = v + 1;
+    }
+}
+
+// [b, e) satirinin hucrelerini ayristirir; okunabilirSon tamponun sonu (e'den sonra gelebilir)
+template<typename F>
+static void matrisSatiriOku(const char* b, const char* e, const char* okunabilirSon, int row, F& kenar) {
+    int col = 0;
+    const char* alanBas = b;
+    const char* p = b;
+#if defined(__AVX2__)
+    const __m256i virgul32 = _mm256_set1_epi8(','), tire32 = _mm256_set1_epi8('-');
+    for (; e - p >= 32; p += 32) {
+        __m256i blok = _mm256_loadu_si256((const __m256i*) p);
+        __m256i v = _mm256_cmpeq_epi8(blok, virgul32), t = _mm256_cmpeq_epi8(blok, tire32);
+        unsigned digerTers = (unsigned) _mm256_movemask_epi8(_mm256_or_si256(v, t));
+        matrisBlogu(p, (unsigned) _mm256_movemask_epi8(v), (unsigned) _mm256_movemask_epi8(t), ~digerTers,
+                    alanBas, col, okunabilirSon, row, kenar);
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i virgul16 = _mm_set1_epi8(','), tire16 = _mm_set1_epi8('-');
+    for (; e - p >= 16; p += 16) {
+        __m128i blok = _mm_loadu_si128((const __m128i*) p);
+        __m128i v = _mm_cmpeq_epi8(blok, virgul16), t = _mm_cmpeq_epi8(blok, tire16);
+        unsigned digerTers = (unsigned) _mm_movemask_epi8(_mm_or_si128(v, t));
+        matrisBlogu(p, (unsigned) _mm_movemask_epi8(v), (unsigned) _mm_movemask_epi8(t), ~digerTers & 0xFFFFu,
+                    alanBas, col, okunabilirSon, row, kenar);
+    }
+#endif
+    for (const char* v; (v = (const char*) std::memchr(p, ',', e - p)) != nullptr; p = v + 1) {
+        matrisHucresi(alanBas, v, okunabilirSon, row, col++, kenar);
+        alanBas = v + 1;
+    }
+    matrisHucresi(alanBas, e, okunabilirSon, row, col, kenar);
+}
+
+// Kalan satirlari okur, her kenar icin kenar(u, v, w) cagirir (0 tabanli dugum; matriste u
+// okunan ilk satira gore). Okunan satir sayisini doner
+template<typename F>
+static int mesafeSatirlariOku(CsvOkuyucu& csv, bool kenarListesi, F kenar) {
+    Alan a, b, c;
+    int row = 0;
+    while (csv.satir()) {
+        if (kenarListesi) {
+            if (csv.alan(a) && csv.alan(b) && csv.alan(c) && a.n && b.n && c.n)
+                kenar(a.tamsayi() - 1, b.tamsayi() - 1, c.tamsayi());
+            continue;
+        }
+        matrisSatiriOku(csv.satirBasi(), csv.satirSonu(), csv.sonu(), row, kenar);
+        row++;
+    }
+    return row;
+}
+
+template<typename F>
+static bool mesafeDosyasiOku(CsvOkuyucu& csv, F kenar) {
+    bool kenarListesi = mesafeBicimiBelirle(csv);
+    mesafeSatirlariOku(csv, kenarListesi, kenar);
+    return kenarListesi;
+}
+
+// Paralel yukleyicide mesafe dosyasinin bir parcasi. Kenarlar (u, v, w) uclusu olarak
+// biriktirilir, matriste u parcanin ilk satirina gore yereldir
+struct KenarParcasi {
+    const char* bas;
+    long long bayt;
+    VecArr<int> uclu;
+    int satirSayisi;
+    KenarParcasi(): bas(nullptr), bayt(0), satirSayisi(0) {}
+};
+
+// Yogun matrisi kenar listesine cevirir (kenar sirasi korunur, yuklenen graf ayni kalir)
+bool matrisiKenarListesineCevir(const char* matrisF, const char* ciktiF) {
+    CsvOkuyucu csv;
+    if (!csv.ac(matrisF)) { std::perror(matrisF); return false; }
+    FILE* fOut = std::fopen(ciktiF, "w");
+    if (!fOut) { std::perror(ciktiF); return false; }
+    std::fprintf(fOut, "u,v,mesafe\n");
+    long long kenarSayisi = 0;
+    bool zatenListe = mesafeDosyasiOku(csv, [fOut, &kenarSayisi](int u, int v, int w) {
+        std::fprintf(fOut, "%d,%d,%d\n", u + 1, v + 1, w);
+        kenarSayisi++;
+    });
+    bool ok = std::fclose(fOut) == 0;
+    if (zatenListe) printf("UYARI: %s zaten kenar listesi\n", matrisF);
+    if (ok) printf("%lld kenar %s dosyasina yazildi\n", kenarSayisi, ciktiF);
+    return ok;
+}
+
+// GRAFI OLUSTUR 
+void grafOlustur(const char* durakListF, const char* hatlarF, const char* mesafeF, Graph& g) {
+    // durak_mesafeleri.txt diger iki dosyaya bagli degil. Yeterince buyukse satir sinirlarinda
+    // parcalara bolunur, parcalar durak ve hat dosyalari okunurken ayri is parcaciklarinda
+    // ayristirilir; kenarlar sonda parca sirasiyla eklendigi icin graf sirali yuklemeyle aynidir.
+    // Uc dosya da isciler baslamadan acilir: hata cikisinda calisan is parcacigi kalmaz
+    CsvOkuyucu mesafeCsv, csv, hatCsv;
+    if (!mesafeCsv.ac(mesafeF)) { std::perror("durak_mesafeleri.txt acilamadi"); std::exit(1); }
+    if (!csv.ac(durakListF)) { std::perror("durak_listesi.txt acilamadi"); std::exit(1); }
+    if (!hatCsv.ac(hatlarF)) { std::perror("hatlar.txt acilamadi"); std::exit(1); }
+    bool kenarListesi = mesafeBicimiBelirle(mesafeCsv);
+    const long long enAzParca = 1 << 20;
+    long long kalan = mesafeCsv.sonu() - mesafeCsv.kalanBas();
+    int parcaSayisi = yuklemeIscisi;
+    if (kalan / enAzParca < parcaSayisi) parcaSayisi = (int) (kalan / enAzParca);
+    if (parcaSayisi < 2) parcaSayisi = 0;
+    KenarParcasi* parcalar = parcaSayisi ? new KenarParcasi[parcaSayisi] : nullptr;
+    VecArr<std::thread*> isciler;
+    const char* p = mesafeCsv.kalanBas();
+    for (int i = 0; i < parcaSayisi; ++i) {
+        const char* son = mesafeCsv.sonu();
+        if (i + 1 < parcaSayisi) {
+            const char* orta = p + (son - p) / (parcaSayisi - i);     // kalan esit bolunur
+            const char* nl = (const char*) std::memchr(orta, '\n', son - orta);
+            if (nl) son = nl + 1;
+        }
+        parcalar[i].bas = p; parcalar[i].bayt = son - p; p = son;
+        KenarParcasi* pc = &parcalar[i];
+        isciler.pushLast(new std::thread([pc, kenarListesi]() {
+            CsvOkuyucu parcaCsv;
+            parcaCsv.baglan(pc->bas, pc->bayt);
+            pc->satirSayisi = mesafeSatirlariOku(parcaCsv, kenarListesi, [pc](int u, int v, int w) {
+                pc->uclu.pushLast(u); pc->uclu.pushLast(v); pc->uclu.pushLast(w);
+            });
+        }));
+    }
+
+    // durak_listesi.txt oku
+    OLCUM_BASLA(Z_YUKLEME_DURAK);
+    csv.satir();
+    Alan a;
+
+    // Diziler en buyuk ID'ye gore boyutlanir; ID satir sayisina gore makul olmali ki tek bir
+    // yazim hatasi (1999999999,X) gigabaytlarca bellek ayirtmasin. Siniri asan satirlar atlanir
+    long long satirN = 0;
+    for (const char* c = csv.veri(), *son = c + csv.bayt(); c && (c = (const char*) std::memchr(c, '\n', son - c)) != nullptr; ++c) satirN++;
+    long long idSiniri = DURAK_ID_KATSAYI * (satirN + 1) + DURAK_ID_PAYI;
+    int atlanan = 0, ilkAtlanan = 0;
+
+    int durakSatirCount = 0;
+    durakSayisi = 0;
+    while (csv.satir()) {
+        if (csv.bosSatir()) continue;
+        if (!csv.alan(a)) continue;
+        int id = a.tamsayi();
+        if (id < 1) continue;
+        if (id > idSiniri) { if (atlanan++ == 0) ilkAtlanan = id; continue; }
+        if (!csv.alan(a)) continue;
+        durakIsimleri.ekle(id, a.p, a.n);
+        if (id > durakSayisi) durakSayisi = id;
+        durakSatirCount++;
+    }
+    durakIsimleri.tamamla();
+    if (atlanan)
+        std::fprintf(stderr, "UYARI: durak_listesi.txt: ID'si %lld'den buyuk %d satir atlandi (ilki %d)\n", idSiniri, atlanan, ilkAtlanan);
+    g.init(durakSayisi, arenaAcik);
+    durakHatIndeksi.baslat(durakSayisi);
+    OLCUM_BITIR(Z_YUKLEME_DURAK);
+
+    // hatlar.txt oku. Bilinen durak adlari isim tablosundaki kopyayi gosterir (tablo bundan
+    // sonra buyumez); yalnizca listede olmayan adlar ayri kopyalanir
+    OLCUM_BASLA(Z_YUKLEME_HAT);
+    hatCsv.satir();
+
+    int hatSatirCount = 0; hatSayisi = 0;
+    while (hatCsv.satir()) {
+        if (hatCsv.bosSatir()) continue;
+        if (!hatCsv.alan(a)) continue;
+        int hatNo = a.tamsayi();
+        if (hatNo <= 0) continue;
+
+        hatNoArr.pushLast(hatNo);
+        if (!hatCsv.alan(a)) hatNameArr.pushLast(strKopya(""));
+        else hatNameArr.pushLast(strKopya(a.p, a.n));
+
+        VecArr<int> dlist;
+        VecArr<char*> isimList;
+        while (hatCsv.alan(a)) {
+            if (a.n == 0) continue;
+            int durakID = durakIsimleri.bul(a.p, a.n);
+            if (durakID != -1) {
+                isimList.pushLast(const_cast<char*>(durakIsimleri.ad(durakID)));
+                dlist.pushLast(durakID); durakHatIndeksi.ekle(durakID, hatNo);
+            } else {
+                isimList.pushLast(strKopya(a.p, a.n));
+            }
+        }
+        hatDuraklari.pushLast(std::move(dlist)); hatDurakAdlari.pushLast(std::move(isimList));
+        hatSayisi++; hatSatirCount++;
+    }
+    durakHatIndeksi.sikistir();
+
+    hatCsv.kapat();
+    OLCUM_BITIR(Z_YUKLEME_HAT);
+
+    // durak_mesafeleri.txt: parcalari bekleyip sirayla ekle ya da burada sirali oku
+    // (paralel yuklemede sure yalnizca bekleme ve eklemeyi kapsar)
+    OLCUM_BASLA(Z_YUKLEME_MESAFE);
+    if (parcaSayisi) {
+        for (int i = 0; i < isciler.size(); ++i) { isciler[i]->join(); delete isciler[i]; }
+        int satirOff = 0;
+        for (int i = 0; i < parcaSayisi; ++i) {
+            const int* k = parcalar[i].uclu.ptr();
+            int n = parcalar[i].uclu.size();
+            for (int j = 0; j < n; j += 3) {
+                int u = kenarListesi ? k[j] : k[j] + satirOff, v = k[j + 1];
+                if (u >= 0 && u < durakSayisi && v >= 0 && v < durakSayisi) g.addEdge(u, v, k[j + 2]);
+            }
+            satirOff += parcalar[i].satirSayisi;
+        }
+        delete[] parcalar;
+    } else {
+        mesafeSatirlariOku(mesafeCsv, kenarListesi, [&g](int u, int v, int w) {
+            if (u >= 0 && u < durakSayisi && v >= 0 && v < durakSayisi) g.addEdge(u, v, w);
+        });
+    }
+    mesafeCsv.kapat();
+    OLCUM_BITIR(Z_YUKLEME_MESAFE);
+
+    // Hat bazli durak dizisinden graf kenarina hatNo ekle
+    OLCUM_BASLA(Z_YUKLEME_HAT_KENAR);
+    for (int h = 0; h < hatSayisi; ++h) {
+        int hatNo = hatNoArr[h];
+        VecArr<int>& dlist = hatDuraklari[h];
+        for (int i = 0; i + 1 < dlist.size(); ++i) {
+            int u = dlist[i] - 1; int v = dlist[i + 1] - 1;
+            g.addLineToEdge(u, v, hatNo);
+        }
+    }
+    OLCUM_BITIR(Z_YUKLEME_HAT_KENAR);
+
+    // Yukleme bitti: komsulugu CSR olarak dondur
+    OLCUM_BASLA(Z_YUKLEME_CSR);
+    g.freeze();
+    OLCUM_BITIR(Z_YUKLEME_CSR);
+}
+
+// AG ANLIK GORUNTUSU
+// --derle yuklenmis agi tek dosyaya yazar; --ag bu dosyayi mmap'leyip metin ayristirmadan acar.
+// Isim tablosu, CSR komsuluk ve durak-hat indeksi dosyanin icinden oldugu gibi kullanilir;
+// hat bazli kucuk diziler bellege kopyalanir, hat ve durak adlari yine dosyayi gosterir
+
+struct AgBasligi {
+    char sihir[4];       // "ULAG"
+    int surum;
+    int durakSayisi;
+    int hatSayisi;
+    long long yukBoyut;  // basliktan sonraki bayt sayisi
+    unsigned toplam;     // yukun FNV-1a ozeti
+    int bos;
+};
+
+static void* anlikHarita = nullptr;     // surec boyunca eslenmis kalir
+static long long anlikBoyut = 0;
+
+// Hat numaralari, adlari, durak ID dizileri ve hatlar.txt'deki ham durak adlari
+static void hatlariAnlikYaz(AnlikYazici& y) {
+    VecArr<int> adOff, durakOff, durakHavuz, isimListeOff, isimOff;
+    VecArr<char> adHavuz, isimHavuz;
+    for (int h = 0; h < hatSayisi; ++h) {
+        adOff.pushLast(adHavuz.size());
+        for (const char* c = hatNameArr[h]; ; ++c) { adHavuz.pushLast(*c); if (!*c) break; }
+        durakOff.pushLast(durakHavuz.size());
+        for (int i = 0; i < hatDuraklari[h].size(); ++i) durakHavuz.pushLast(hatDuraklari[h][i]);
+        isimListeOff.pushLast(isimOff.size());
+        for (int i = 0; i < hatDurakAdlari[h].size(); ++i) {
+            isimOff.pushLast(isimHavuz.size());
+            for (const char* c = hatDurakAdlari[h][i]; ; ++c) { isimHavuz.pushLast(*c); if (!*c) break; }
+        }
+    }
+    durakOff.pushLast(durakHavuz.size());
+    isimListeOff.pushLast(isimOff.size());
+    y.dizi(hatNoArr.ptr(), hatSayisi);
+    y.dizi(adOff.ptr(), adOff.size());
+    y.dizi(adHavuz.ptr(), adHavuz.size());
+    y.dizi(durakOff.ptr(), durakOff.size());
+    y.dizi(durakHavuz.ptr(), durakHavuz.size());
+    y.dizi(isimListeOff.ptr(), isimListeOff.size());
+    y.dizi(isimOff.ptr(), isimOff.size());
+    y.dizi(isimHavuz.ptr(), isimHavuz.size());
+}
+
+static bool hatlariAnlikBagla(AnlikOkuyucu& o, int beklenenHat) {
+    int nNo, nAdOff, nAd, nDurakOff, nDurak, nListeOff, nIsimOff, nIsim;
+    const int* no = o.dizi<int>(nNo);
+    const int* adOff = o.dizi<int>(nAdOff);
+    const char* ad = o.dizi<char>(nAd);
+    const int* durakOff = o.dizi<int>(nDurakOff);
+    const int* durak = o.dizi<int>(nDurak);
+    const int* listeOff = o.dizi<int>(nListeOff);
+    const int* isimOff = o.dizi<int>(nIsimOff);
+    const char* isim = o.dizi<char>(nIsim);
+    if (!o.ok || nNo != beklenenHat || nAdOff != nNo || nDurakOff != nNo + 1 || nListeOff != nNo + 1
+        || durakOff[nNo] != nDurak || listeOff[nNo] != nIsimOff) return false;
+    hatSayisi = nNo;
+    hatNoArr.reserve(nNo); hatNameArr.reserve(nNo);
+    hatDuraklari.reserve(nNo); hatDurakAdlari.reserve(nNo);
+    for (int h = 0; h < nNo; ++h) {
+        hatNoArr.pushLast(no[h]);
+        hatNameArr.pushLast(const_cast<char*>(ad + adOff[h]));
+        VecArr<int> dlist;
+        dlist.reserve(durakOff[h + 1] - durakOff[h]);
+        for (int i = durakOff[h]; i < durakOff[h + 1]; ++i) dlist.pushLast(durak[i]);
+        VecArr<char*> isimList;
+        isimList.reserve(listeOff[h + 1] - listeOff[h]);
+        for (int i = listeOff[h]; i < listeOff[h + 1]; ++i) isimList.pushLast(const_cast<char*>(isim + isimOff[i]));
+        hatDuraklari.pushLast(std::move(dlist)); hatDurakAdlari.pushLast(std::move(isimList));
+    }
+    return true;
+}
+
+bool agAnlikKaydet(const char* dosya) {
+    FILE* f = std::fopen(dosya, "wb");
+    if (!f) { std::perror(dosya); return false; }
+    AgBasligi b;
+    std::memset(&b, 0, sizeof(b));
+    std::memcpy(b.sihir, "ULAG", 4);
+    b.surum = 1; b.durakSayisi = durakSayisi; b.hatSayisi = hatSayisi;
+    bool ok = std::fwrite(&b, sizeof(b), 1, f) == 1;
+    AnlikYazici y(f);
+    durakIsimleri.anlikYaz(y);
+    hatlariAnlikYaz(y);
+    globalGraph.anlikYaz(y);
+    durakHatIndeksi.anlikYaz(y);
+    // ozet ve boyut yuk yazildiktan sonra belli olur
+    b.yukBoyut = y.yazilan; b.toplam = y.toplam;
+    ok = ok && y.ok && std::fseek(f, 0, SEEK_SET) == 0 && std::fwrite(&b, sizeof(b), 1, f) == 1;
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) std::fprintf(stderr, "%s: anlik goruntu yazilamadi\n", dosya);
+    return ok;
+}
+
+bool agAnlikYukle(const char* dosya) {
+    int fd = ::open(dosya, O_RDONLY);
+    if (fd < 0) { std::perror(dosya); return false; }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(AgBasligi)) {
+        std::fprintf(stderr, "%s: gecersiz anlik goruntu\n", dosya); ::close(fd); return false;
+    }
+    void* harita = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (harita == MAP_FAILED) { std::perror("mmap"); return false; }
+    const char* taban = (const char*) harita;
+    AgBasligi b;
+    std::memcpy(&b, taban, sizeof(b));
+    const char* hata = nullptr;
+    if (std::memcmp(b.sihir, "ULAG", 4) != 0 || b.surum != 1) hata = "gecersiz anlik goruntu";
+    else if (b.yukBoyut != (long long) st.st_size - (long long) sizeof(b)) hata = "dosya boyutu tutmuyor";
+    else if (fnvOzet(taban + sizeof(b), b.yukBoyut) != b.toplam) hata = "ozet tutmuyor";
+    if (!hata) {
+        AnlikOkuyucu o(taban + sizeof(b), b.yukBoyut);
+        durakSayisi = b.durakSayisi;
+        if (!durakIsimleri.anlikBagla(o) || !hatlariAnlikBagla(o, b.hatSayisi)
+            || !globalGraph.anlikBagla(o) || !durakHatIndeksi.anlikBagla(o)
+            || globalGraph.vertexCount() != durakSayisi) hata = "bolumler okunamadi";
+    }
+    if (hata) {
+        std::fprintf(stderr, "%s: %s\n", dosya, hata);
+        ::munmap(harita, st.st_size);
+        return false;
+    }
+    anlikHarita = harita; anlikBoyut = st.st_size;
+    return true;
+}
+
+// Durak Ara 
+void durakAra(int durakID, FILE* out) {
+    if (durakID < 1 || durakID > durakSayisi) {
+        std::fprintf(out, "HATA: Geçersiz durakID=%d\n", durakID); return;
+    }
+    int hatSayCount = durakHatIndeksi.hatSayisi(durakID);
+    if (hatSayCount == 0) {
+        std::fprintf(out, "Durak ID %d bulunamadi.\n", durakID); return;
+    }
+    std::fprintf(out, "Durak: %s (%d)\n", durakAdi(durakID), durakID);
+    std::fprintf(out, "  Bulundugu Hatlar:");
+    const int* hl = durakHatIndeksi.hatlar(durakID);
+    for (int i = 0; i < hatSayCount; ++i) std::fprintf(out, " %d", hl[i]);
+    std::fprintf(out, "\n");
+}
+
+//  Tüm Hatları Listele 
+void tumHatlariListele(FILE* out) {
+    std::fprintf(out, "\n--- Tüm Hatlar ---\n");
+    for (int i = 0; i < hatSayisi; ++i) {
+        std::fprintf(out, "Hat %d  (%s)\n", hatNoArr[i], hatNameArr[i]);
+    }
+    std::fprintf(out, ">>> Toplam hat sayisi: %d\n", hatSayisi);
+}
+
+// Bir Hattın Duraklarını Göster 
+void hatDuraklariGoster(int hatNo, FILE* out) {
+    if (hatNo <= 0) { std::fprintf(out, "Gecersiz hat numarasi.\n"); return; }
+    int idx = -1;
+    for (int i = 0; i < hatSayisi; ++i) if (hatNoArr[i] == hatNo) { idx = i; break; }
+    if (idx < 0) { std::fprintf(out, "HATA: Hat %d bulunamadi.\n", hatNo); return; }
+
+    VecArr<char*>& isimList = hatDurakAdlari[idx];
+    if (isimList.size() == 0) {
+        std::fprintf(out, "HatNo %d (%s) icin durak yok.\n", hatNoArr[idx], hatNameArr[idx]);
+        return;
+    }
+    std::fprintf(out, "\nHatNo %d (%s) Duraklar (%d):\n", hatNoArr[idx], hatNameArr[idx], isimList.size());
+    for (int i = 0; i < isimList.size(); ++i) {
+        if (isimList[i] == nullptr) { std::fprintf(out, "  [GECERSİZ durak ismi]\n"); continue; }
+        const char* name = isimList[i];
+        int durakID = findDurakIDbyName(name);
+        if (durakID < 1 || durakID > durakSayisi) { std::fprintf(out, "  %s [Gecersiz Durak]\n", name); }
+        else { std::fprintf(out, "  %s (%d)\n", name, durakID); }
+    }
+    std::fprintf(out, ">>> HatNo %d icin toplam %d durak bulundu.\n", hatNo, isimList.size());
+}
+
+// Yardimci: dijkstra agacindan hedefe giden rotayi (0 tabanli dugumler, kaynaktan hedefe) cikar
+static int parentRotasi(const int* dist, const int* parent, int hedef, int* path) {
+    OLCUM_KAPSAM(Z_SORGU_ROTA);
+    if (dist[hedef] == INT_MAX) return 0;
+    int pathLen = 0;
+    int crawl = hedef; path[pathLen++] = crawl;
+    while (parent[crawl] != -1) { crawl = parent[crawl]; path[pathLen++] = crawl; }
+    for (int i = 0; i < pathLen/2; i++) { int temp = path[i]; path[i] = path[pathLen-1-i]; path[pathLen-1-i] = temp; }
+    return pathLen;
+}
+
+// TARIFE VE SEFER PLANLAMA
+// --tarife <dosya>: "hatNo,ilk,son,aralik[,sure,sure,...]" satirlari. Hat ilk duragindan ilk..son
+// arasinda her aralik dakikada bir kalkar (saat SS:DD ya da gece yarisindan dakika; aralik <= 0 tek
+// sefer). Ayni hatNo icin birden cok satir (zirve saatleri gibi) verilebilir. Bolum sureleri
+// (dakika) hattin durak sayisinin bir eksigi kadarsa kullanilir, yoksa graf agirligi dakika sayilir.
+// Her hat bir rota olur; seferleri ayni bolum surelerini kullandigindan birbirini sollamaz, bir
+// duraktan binilecek en erken sefer kalkis dizisinde ikili aramayla bulunur. Rotalar, seferler ve
+// durak -> (rota, sira) indeksi duz dizilerde tutulur
+
+// Yardimci: "SS:DD" ya da dakika -> gece yarisindan dakika, gecersizse -1
+static int saatAyristir(const char* p, int n) {
+    int i = 0, s = 0, d = 0;
+    if (i >= n || p[i] < '0' || p[i] > '9') return -1;
+    while (i < n && p[i] >= '0' && p[i] <= '9' && s < 100000) s = s * 10 + (p[i++] - '0');
+    if (i == n) return s;
+    if (p[i++] != ':' || i >= n) return -1;
+    while (i < n && p[i] >= '0' && p[i] <= '9' && d < 100) d = d * 10 + (p[i++] - '0');
+    if (i != n || d >= 60) return -1;
+    return s * 60 + d;
+}
+
+// Yardimci: dakika -> "SS:DD" (gece yarisini gecen seferler 24:10 gibi yazilir)
+static void saatYaz(char* buf, int boyut, int dk) {
+    std::snprintf(buf, boyut, "%02d:%02d", dk / 60, dk % 60);
+}
+
+// Bir is parcacigina ait tur etiketleri: (tur sayisi + 1) * V boyunda varis ve geri izleme dizileri
+struct SeferTamponu {
+    int V, R, K;
+    int* varis;           // [k * V + p]: en cok k aracla p'ye en erken varis
+    int* binis;           // o turda iyilestiyse binilen yer (rota duragi dizisinde), yoksa -1
+    int* inis;            // inilen yer
+    int* sefer;
+    int* enIyi;           // turlar boyunca en iyi varis (yerel budama)
+    char* isaretli;
+    int* isaretListe;
+    int* kuyrukSira;      // rota -> kuyruktaysa taramaya baslanacak en kucuk sira, yoksa -1
+    int* kuyruk;
+
+    SeferTamponu(): V(0), R(0), K(0), varis(nullptr), binis(nullptr), inis(nullptr), sefer(nullptr), enIyi(nullptr),
+                    isaretli(nullptr), isaretListe(nullptr), kuyrukSira(nullptr), kuyruk(nullptr) {}
+    ~SeferTamponu() { birak(); }
+
+    void birak() {
+        std::free(varis); std::free(binis); std::free(inis); std::free(sefer); std::free(enIyi);
+        std::free(isaretli); std::free(isaretListe); std::free(kuyrukSira); std::free(kuyruk);
+        varis = binis = inis = sefer = enIyi = isaretListe = kuyrukSira = kuyruk = nullptr;
+        isaretli = nullptr;
+        V = R = K = 0;
+    }
+
+    // Canli hat guncellemesi rota sayisini degistirebilir; aramadan once gerekirse yeniden ayir
+    void hazirla(int v, int r, int k) {
+        if (v <= V && r <= R && k <= K) return;
+        birak();
+        V = v; R = r > 0 ? r : 1; K = k;
+        long long etiket = (long long) (K + 1) * V;
+        varis = (int*) std::malloc(sizeof(int) * etiket);
+        binis = (int*) std::malloc(sizeof(int) * etiket);
+        inis = (int*) std::malloc(sizeof(int) * etiket);
+        sefer = (int*) std::malloc(sizeof(int) * etiket);
+        enIyi = (int*) std::malloc(sizeof(int) * V);
+        isaretli = (char*) std::calloc(V, 1);
+        isaretListe = (int*) std::malloc(sizeof(int) * V);
+        kuyrukSira = (int*) std::malloc(sizeof(int) * R);
+        kuyruk = (int*) std::malloc(sizeof(int) * R);
+        for (int i = 0; i < R; ++i) kuyrukSira[i] = -1;
+    }
+};
+
+struct TarifeSatiri {
+    int hatNo, ilk, son, aralik;
+    int sureOff, sureN;      // bolum sureleri (sureler icinde)
+};
+
+// Bir Pareto yolculugu: tur (kullanilan arac sayisi) ve hedefe varis
+struct SeferSonucu {
+    int tur;
+    int varis;
+};
+
+class Tarife {
+private:
+    VecArr<TarifeSatiri> satirlar;
+    VecArr<int> sureler;
+    int V, R;
+    int* rotaHat;            // R: hatNoArr indeksi
+    int* rotaDurakOff;       // R+1
+    int* rotaDurak;          // rota duraklari (0 tabanli)
+    int* rotaSure;           // rotanin ilk duragindan bu duraga dakika (rotaDurak ile paralel)
+    int* rotaSeferOff;       // R+1
+    int* seferKalkis;        // rota icinde artan sirali, ilk duraktan kalkis
+    int* durakRotaOff;       // V+1: durak -> [durakRotaOff[p], durakRotaOff[p+1]) girdileri
+    int* durakRota;
+    int* durakSira;          // rotadaki sira (ayni rotada tekrar eden durak iki girdi alir)
+
+    static int* diziKopyala(const VecArr<int>& v) {
+        int* c = (int*) std::malloc(sizeof(int) * (v.size() > 0 ? v.size() : 1));
+        if (v.size() > 0) std::memcpy(c, v.ptr(), sizeof(int) * v.size());
+        return c;
+    }
+
+    // rotanin sira'daki duragindan esik veya sonrasinda kalkan ilk sefer, yoksa -1
+    int enErkenSefer(int r, int sira, int esik) const {
+        int hedef = esik - rotaSure[rotaDurakOff[r] + sira];
+        int lo = rotaSeferOff[r], hi = rotaSeferOff[r + 1];
+        while (lo < hi) {
+            int m = (lo + hi) / 2;
+            if (seferKalkis[m] < hedef) lo = m + 1; else hi = m;
+        }
+        return lo < rotaSeferOff[r + 1] ? lo : -1;
+    }
+
+public:
+    int aktarmaSuresi;       // --aktarma-suresi: aractan inip baska araca binmek icin en az dakika
+
+    Tarife(): V(0), R(0), rotaHat(nullptr), rotaDurakOff(nullptr), rotaDurak(nullptr), rotaSure(nullptr),
+              rotaSeferOff(nullptr), seferKalkis(nullptr), durakRotaOff(nullptr), durakRota(nullptr),
+              durakSira(nullptr), aktarmaSuresi(0) {}
+    ~Tarife() { temizle(); }
+
+    void temizle() {
+        std::free(rotaHat); std::free(rotaDurakOff); std::free(rotaDurak); std::free(rotaSure);
+        std::free(rotaSeferOff); std::free(seferKalkis);
+        std::free(durakRotaOff); std::free(durakRota); std::free(durakSira);
+        rotaHat = rotaDurakOff = rotaDurak = rotaSure = rotaSeferOff = seferKalkis = nullptr;
+        durakRotaOff = durakRota = durakSira = nullptr;
+        V = R = 0;
+    }
+
+    bool hazir() const { return rotaHat != nullptr; }
+    int rotaSayisi() const { return R; }
+    int seferSayisi() const { return hazir() ? rotaSeferOff[R] : 0; }
+
+    void satirEkle(int hatNo, int ilk, int son, int aralik, const int* sure = nullptr, int sureN = 0) {
+        TarifeSatiri s;
+        s.hatNo = hatNo; s.ilk = ilk; s.son = son; s.aralik = aralik;
+        s.sureOff = sureler.size(); s.sureN = sureN;
+        for (int i = 0; i < sureN; ++i) sureler.pushLast(sure[i]);
+        satirlar.pushLast(s);
+    }
+
+    // Tarife dosyasini okur (baslik ve gecersiz satirlar atlanir); kur() ayrica cagrilmali
+    bool yukle(const char* dosya) {
+        CsvOkuyucu csv;
+        if (!csv.ac(dosya)) { std::perror("tarife dosyasi acilamadi"); return false; }
+        Alan a;
+        VecArr<int> sure;
+        while (csv.satir()) {
+            if (csv.bosSatir() || !csv.alan(a)) continue;
+            int hatNo = a.tamsayi();
+            if (hatNo <= 0) continue;
+            int deger[3];
+            bool tamam = true;
+            for (int i = 0; i < 3 && tamam; ++i) {
+                if (!csv.alan(a)) { tamam = false; break; }
+                deger[i] = (i < 2) ? saatAyristir(a.p, a.n) : a.tamsayi();
+                if (deger[i] < 0 && i < 2) tamam = false;
+            }
+            if (!tamam) continue;
+            sure = VecArr<int>();
+            while (csv.alan(a)) sure.pushLast(a.tamsayi() > 0 ? a.tamsayi() : 0);
+            satirEkle(hatNo, deger[0], deger[1], deger[2], sure.ptr(), sure.size());
+        }
+        return true;
+    }
+
+    // Satirlari hatDuraklari'na uygular. Canli hat ve mesafe guncellemelerinden sonra yeniden cagrilir
+    void kur(const Graph& g) {
+        temizle();
+        V = g.vertexCount();
+        VecArr<int> rh, doff, dd, ds, soff, sk;
+        for (int h = 0; h < hatSayisi; ++h) {
+            const VecArr<int>& dlist = hatDuraklari[h];
+            int n = dlist.size();
+            if (n < 2) continue;
+            int seferBas = sk.size(), sureSatiri = -1;
+            for (int j = 0; j < satirlar.size(); ++j) {
+                const TarifeSatiri& s = satirlar[j];
+                if (s.hatNo != hatNoArr[h]) continue;
+                for (int t = s.ilk; t <= s.son; t += s.aralik) {
+                    sk.pushLast(t);
+                    if (s.aralik <= 0) break;
+                }
+                if (sureSatiri == -1 && s.sureN == n - 1) sureSatiri = j;
+            }
+            if (sk.size() == seferBas) continue;        // tarifesiz hat
+            for (int i = seferBas + 1; i < sk.size(); ++i) {
+                int x = sk[i], j = i - 1;
+                while (j >= seferBas && sk[j] > x) { sk[j + 1] = sk[j]; --j; }
+                sk[j + 1] = x;
+            }
+            rh.pushLast(h); doff.pushLast(dd.size()); soff.pushLast(seferBas);
+            int t = 0;
+            for (int i = 0; i < n; ++i) {
+                dd.pushLast(dlist[i] - 1); ds.pushLast(t);
+                if (i + 1 == n) break;
+                int w = sureSatiri != -1 ? sureler[satirlar[sureSatiri].sureOff + i]
+                                         : g.asilAgirlik(dlist[i] - 1, dlist[i + 1] - 1);
+                t += (w > 0) ? w : 1;                   // kenari olmayan bolum 1 dakika sayilir
+            }
+        }
+        R = rh.size();
+        doff.pushLast(dd.size()); soff.pushLast(sk.size());
+        rotaHat = diziKopyala(rh); rotaDurakOff = diziKopyala(doff); rotaDurak = diziKopyala(dd);
+        rotaSure = diziKopyala(ds); rotaSeferOff = diziKopyala(soff); seferKalkis = diziKopyala(sk);
+
+        // durak -> (rota, sira): sayarak siralama
+        durakRotaOff = (int*) std::calloc(V + 1, sizeof(int));
+        for (int i = 0; i < dd.size(); ++i) durakRotaOff[dd[i] + 1]++;
+        for (int p = 0; p < V; ++p) durakRotaOff[p + 1] += durakRotaOff[p];
+        int* yer = (int*) std::malloc(sizeof(int) * (V > 0 ? V : 1));
+        for (int p = 0; p < V; ++p) yer[p] = durakRotaOff[p];
+        durakRota = (int*) std::malloc(sizeof(int) * (dd.size() > 0 ? dd.size() : 1));
+        durakSira = (int*) std::malloc(sizeof(int) * (dd.size() > 0 ? dd.size() : 1));
+        for (int r = 0; r < R; ++r)
+            for (int i = rotaDurakOff[r]; i < rotaDurakOff[r + 1]; ++i) {
+                int k = yer[dd[i]]++;
+                durakRota[k] = r; durakSira[k] = i - rotaDurakOff[r];
+            }
+        std::free(yer);
+    }
+
+    // Tur tabanli arama (RAPTOR): k. tur en cok k aracla varislari, k-1. turun isaretli duraklarindan
+    // gecen rotalari bir kez tarayarak bulur. Hedefin varisi iyilesen her tur bir Pareto yolculugudur
+    // (daha cok aktarma, daha erken varis); sonuc'a tur sirasiyla yazilir, sayisi doner. Kapali
+    // duraklarda binilip inilmez
+    int planla(int bas, int bit, int kalkis, int enCokTur, SeferTamponu& t, SeferSonucu* sonuc) const {
+        if (!hazir() || bas < 0 || bas >= V || bit < 0 || bit >= V) return 0;
+        if (globalGraph.durakKapaliMi(bas) || globalGraph.durakKapaliMi(bit)) return 0;
+        if (bas == bit) { sonuc[0].tur = 0; sonuc[0].varis = kalkis; return 1; }
+        t.hazirla(V, R, enCokTur);
+        for (int p = 0; p < V; ++p) { t.varis[p] = INT_MAX; t.enIyi[p] = INT_MAX; }
+        t.varis[bas] = t.enIyi[bas] = kalkis;
+        int isaretSayisi = 0, adet = 0;
+        t.isaretli[bas] = 1; t.isaretListe[isaretSayisi++] = bas;
+        for (int k = 1; k <= enCokTur && isaretSayisi > 0; ++k) {
+            const int* onceki = t.varis + (long long) (k - 1) * V;
+            int* simdi = t.varis + (long long) k * V;
+            int* binis = t.binis + (long long) k * V;
+            int* inis = t.inis + (long long) k * V;
+            int* sefer = t.sefer + (long long) k * V;
+            std::memcpy(simdi, onceki, sizeof(int) * V);
+            for (int p = 0; p < V; ++p) binis[p] = -1;
+
+            // isaretli duraklardan gecen rotalar, her biri en erken sirasindan
+            int kuyrukN = 0;
+            for (int i = 0; i < isaretSayisi; ++i) {
+                int p = t.isaretListe[i];
+                t.isaretli[p] = 0;
+                for (int j = durakRotaOff[p]; j < durakRotaOff[p + 1]; ++j) {
+                    int r = durakRota[j];
+                    if (t.kuyrukSira[r] == -1) { t.kuyruk[kuyrukN++] = r; t.kuyrukSira[r] = durakSira[j]; }
+                    else if (durakSira[j] < t.kuyrukSira[r]) t.kuyrukSira[r] = durakSira[j];
+                }
+            }
+            isaretSayisi = 0;
+
+            for (int q = 0; q < kuyrukN; ++q) {
+                int r = t.kuyruk[q];
+                int off = rotaDurakOff[r], n = rotaDurakOff[r + 1] - off;
+                int s = -1, binilen = -1;
+                OLCUM_SAY(S_GEVSETME, n - t.kuyrukSira[r]);
+                for (int i = t.kuyrukSira[r]; i < n; ++i) {
+                    int p = rotaDurak[off + i];
+                    if (globalGraph.durakKapaliMi(p)) continue;
+                    if (s != -1) {
+                        int v = seferKalkis[s] + rotaSure[off + i];
+                        int sinir = t.enIyi[p] < t.enIyi[bit] ? t.enIyi[p] : t.enIyi[bit];
+                        if (v < sinir) {
+                            simdi[p] = t.enIyi[p] = v;
+                            binis[p] = binilen; inis[p] = off + i; sefer[p] = s;
+                            if (!t.isaretli[p]) { t.isaretli[p] = 1; t.isaretListe[isaretSayisi++] = p; }
+                        }
+                    }
+                    // onceki turda buraya daha erken varildiysa daha erken sefere binilebilir
+                    if (onceki[p] == INT_MAX) continue;
+                    int esik = onceki[p] + (p == bas ? 0 : aktarmaSuresi);
+                    if (s != -1 && seferKalkis[s] + rotaSure[off + i] <= esik) continue;
+                    int yeni = enErkenSefer(r, i, esik);
+                    if (yeni != -1 && (s == -1 || yeni < s)) { s = yeni; binilen = off + i; }
+                }
+                t.kuyrukSira[r] = -1;
+            }
+            if (simdi[bit] < onceki[bit]) { sonuc[adet].tur = k; sonuc[adet].varis = simdi[bit]; adet++; }
+            OLCUM_SAY(S_YERLESEN, isaretSayisi);
+        }
+        for (int i = 0; i < isaretSayisi; ++i) t.isaretli[t.isaretListe[i]] = 0;   // tur siniri: tampon temiz kalsin
+        return adet;
+    }
+
+    // planla sonrasi tur'daki yolculugun ayaklarini sondan basa izleyip sirayla yazar
+    void yolculukYaz(FILE* out, int bas, int bit, int tur, const SeferTamponu& t) const {
+        int ayakBinis[64], ayakInis[64], ayakSefer[64], n = 0;
+        int p = bit;
+        for (int k = tur; k > 0 && p != bas && n < 64; --k) {
+            long long i = (long long) k * V + p;
+            if (t.binis[i] == -1) continue;             // bu turda iyilesmedi, etiket onceki turdan
+            ayakBinis[n] = t.binis[i]; ayakInis[n] = t.inis[i]; ayakSefer[n] = t.sefer[i];
+            n++;
+            p = rotaDurak[t.binis[i]];
+        }
+        for (int j = n - 1; j >= 0; --j) {
+            // yerin ait oldugu rota: rotaDurakOff'ta ikili arama
+            int lo = 0, hi = R - 1;
+            while (lo < hi) {
+                int m = (lo + hi + 1) / 2;
+                if (rotaDurakOff[m] <= ayakBinis[j]) lo = m; else hi = m - 1;
+            }
+            int h = rotaHat[lo], b = rotaDurak[ayakBinis[j]], v = rotaDurak[ayakInis[j]];
+            char k1[16], k2[16];
+            saatYaz(k1, sizeof(k1), seferKalkis[ayakSefer[j]] + rotaSure[ayakBinis[j]]);
+            saatYaz(k2, sizeof(k2), seferKalkis[ayakSefer[j]] + rotaSure[ayakInis[j]]);
+            std::fprintf(out, "     %s %s (%d) -> %s %s (%d)  [Hat: %d %s, %d durak]\n", k1, durakAdi(b + 1), b + 1,
+                         k2, durakAdi(v + 1), v + 1, hatNoArr[h], hatNameArr[h], ayakInis[j] - ayakBinis[j]);
+        }
+    }
+};
+
+static Tarife tarife;                    // --tarife ile yuklenirse SEFER sorgulari buradan cevaplanir
+static const int SEFER_TUR_SINIRI = 8;   // en cok 8 arac (7 aktarma)
+
+// Yardimci: SEFER cevabi (Pareto yolculuklari, aktarma sayisi artarken varis erkenlesir)
+static void seferYazdir(FILE* out, int basID, int bitID, int kalkis, SeferTamponu& t) {
+    char saat[16];
+    saatYaz(saat, sizeof(saat), kalkis);
+    std::fprintf(out, "\nSefer: %s (%d) -> %s (%d), kalkis %s\n", durakAdi(basID), basID, durakAdi(bitID), bitID, saat);
+    SeferSonucu sonuc[SEFER_TUR_SINIRI + 1];
+    int n = tarife.planla(basID - 1, bitID - 1, kalkis, SEFER_TUR_SINIRI, t, sonuc);
+    if (n == 0) { std::fprintf(out, "  %s sonrasinda tarifeli yolculuk bulunamadi.\n", saat); return; }
+    for (int i = 0; i < n; ++i) {
+        saatYaz(saat, sizeof(saat), sonuc[i].varis);
+        std::fprintf(out, "  %d) varis %s, %d dk, %d aktarma\n", i + 1, saat, sonuc[i].varis - kalkis,
+                     sonuc[i].tur > 0 ? sonuc[i].tur - 1 : 0);
+        tarife.yolculukYaz(out, basID - 1, bitID - 1, sonuc[i].tur, t);
+    }
+}
+
+// Bir is parcacigina ait arama tamponlari; yukleme bittikten sonra olusturulmali
+struct AramaTamponu {
+    int* dist;
+    int* parent;
+    int* path;
+    int* distB;           // cift yonlu aramanin geri tarafi
+    int* parentB;
+    int settled;          // son noktadan noktaya aramada yerlesen dugum sayisi
+    int* hatlar;          // aktarma motoru kullanildiysa path[i]->path[i+1] bolumunun hatti
+    bool hatliMi;
+    int* durumDist;       // aktarma motoru icin (durum sayisi + 1)
+    int* durumParent;
+    int durumCap;
+    SeferTamponu sefer;   // tarife sorgulari icin, ilk SEFER'de ayrilir
+    HiyerarsiTamponu hiyerarsiT;     // daraltma hiyerarsisi sorgulari icin, ilk sorguda ayrilir
+
+    AramaTamponu(): settled(0), hatliMi(false) {
+        int n = durakSayisi > 0 ? durakSayisi : 1;
+        int s = aktarmaMotoru.durumSayisi() + 1;
+        dist = (int*) std::malloc(sizeof(int) * n);
+        parent = (int*) std::malloc(sizeof(int) * n);
+        path = (int*) std::malloc(sizeof(int) * n);
+        distB = (int*) std::malloc(sizeof(int) * n);
+        parentB = (int*) std::malloc(sizeof(int) * n);
+        hatlar = (int*) std::malloc(sizeof(int) * n);
+        durumDist = (int*) std::malloc(sizeof(int) * s);
+        durumParent = (int*) std::malloc(sizeof(int) * s);
+        durumCap = s;
+    }
+
+    // Canli hat guncellemesi durum sayisini buyutebilir; aramadan once gerekirse genislet
+    void durumHazirla() {
+        int s = aktarmaMotoru.durumSayisi() + 1;
+        if (s <= durumCap) return;
+        std::free(durumDist); std::free(durumParent);
+        durumDist = (int*) std::malloc(sizeof(int) * s);
+        durumParent = (int*) std::malloc(sizeof(int) * s);
+        durumCap = s;
+    }
+    ~AramaTamponu() {
+        std::free(dist); std::free(parent); std::free(path); std::free(hatlar);
+        std::free(distB); std::free(parentB);
+        std::free(durumDist); std::free(durumParent);
+    }
+};
+
+// Tek kaynakli en kisa yol agaclari (dist + parent) icin sinirli LRU onbellek. Anahtar kaynak
+// dugumdur; her kayit agacin kuruldugu graf surumunu ve aktarma cezasini tasir, uyusmazsa iska
+// sayilir. Kapasite bellek sinirindan cikar (kayit basina 2 * n int). Sunucu iscileri arasinda
+// tek mutex ile paylasilir; isabette rota kilit altinda agactan cikarilir (O(yol uzunlugu))
+class YolAgaciOnbellegi {
+private:
+    struct Kayit {
+        int kaynak;
+        unsigned surum;
+        int ceza;
+        int* dist;
+        int* parent;
+        int onceki, sonraki;     // LRU listesi
+    };
+    std::mutex kilit;
+    int V;                       // kaynak sayisi
+    int n;                       // agac boyu (dugum ya da aktarma durumu sayisi)
+    int kapasite;
+    long long butce;             // kur'a verilen bellek siniri
+    int kayitSayisi;
+    int* yuva;                   // kaynak -> kayit, -1 = yok
+    Kayit* kayitlar;
+    int enYeni, enEski;
+
+    void listedenCikar(int k) {
+        Kayit& r = kayitlar[k];
+        if (r.onceki != -1) kayitlar[r.onceki].sonraki = r.sonraki; else enYeni = r.sonraki;
+        if (r.sonraki != -1) kayitlar[r.sonraki].onceki = r.onceki; else enEski = r.onceki;
+    }
+
+    void basaKoy(int k) {
+        Kayit& r = kayitlar[k];
+        r.onceki = -1; r.sonraki = enYeni;
+        if (enYeni != -1) kayitlar[enYeni].onceki = k;
+        enYeni = k;
+        if (enEski == -1) enEski = k;
+    }
+
+public:
+    long long isabet, iska, tahliye;
+
+    YolAgaciOnbellegi(): V(0), n(0), kapasite(0), butce(0), kayitSayisi(0), yuva(nullptr), kayitlar(nullptr),
+                         enYeni(-1), enEski(-1), isabet(0), iska(0), tahliye(0) {}
+    ~YolAgaciOnbellegi() { kapat(); }
+
+    void kapat() {
+        for (int k = 0; k < kayitSayisi; ++k) { std::free(kayitlar[k].dist); std::free(kayitlar[k].parent); }
+        std::free(kayitlar); std::free(yuva);
+        kayitlar = nullptr; yuva = nullptr;
+        V = n = kapasite = kayitSayisi = 0;
+        enYeni = enEski = -1;
+        isabet = iska = tahliye = 0;
+    }
+
+    // v kaynak, agacBoyu elemanli agaclar, en fazla bayt kadar agac verisi
+    void kur(int v, int agacBoyu, long long bayt) {
+        kapat();
+        V = v; n = agacBoyu; butce = bayt;
+        long long k = bayt / (2LL * sizeof(int) * (n > 0 ? n : 1));
+        kapasite = (int) (k < V ? k : V);
+        if (kapasite < 1) { kapasite = 0; return; }
+        yuva = (int*) std::malloc(sizeof(int) * V);
+        for (int i = 0; i < V; ++i) yuva[i] = -1;
+        kayitlar = (Kayit*) std::malloc(sizeof(Kayit) * kapasite);
+    }
+
+    bool hazir() const { return kapasite > 0; }
+
+    // Agac boyu degistiyse (aktarma durum sayisi) ayni butceyle bastan kurar; kayitlar zaten eski surumdedir
+    void agacBoyuAyarla(int agacBoyu) {
+        if (!hazir() || agacBoyu == n) return;
+        std::lock_guard<std::mutex> kl(kilit);
+        int v = V; long long b = butce;
+        long long i = isabet, s = iska, t = tahliye;
+        kur(v, agacBoyu, b);
+        isabet = i; iska = s; tahliye = t;
+    }
+
+    // Sayaclar: isabet/iska/tahliye, dolu kayit ve bellek
+    void istatistikYaz(FILE* out) {
+        std::lock_guard<std::mutex> kl(kilit);
+        long long toplam = isabet + iska;
+        std::fprintf(out, "Onbellek: %d/%d agac, %.2f MB, isabet %lld, iska %lld (%%%.1f isabet), tahliye %lld\n",
+                     kayitSayisi, kapasite, (double) kayitSayisi * 2 * n * sizeof(int) / (1024.0 * 1024.0),
+                     isabet, iska, toplam ? 100.0 * isabet / toplam : 0.0, tahliye);
+    }
+
+    // Gecerli bir agac varsa f(dist, parent) kilit altinda cagirilir ve true doner
+    template<typename F>
+    bool kullan(int kaynak, unsigned surum, int ceza, F f) {
+        std::lock_guard<std::mutex> kl(kilit);
+        int k = (kaynak >= 0 && kaynak < V) ? yuva[kaynak] : -1;
+        if (k == -1 || kayitlar[k].surum != surum || kayitlar[k].ceza != ceza) { iska++; return false; }
+        isabet++;
+        listedenCikar(k); basaKoy(k);
+        f(kayitlar[k].dist, kayitlar[k].parent);
+        return true;
+    }
+
+    // Agacin kopyasini saklar; yer yoksa en eski kayit tahliye edilir
+    void ekle(int kaynak, unsigned surum, int ceza, const int* dist, const int* parent) {
+        if (kaynak < 0 || kaynak >= V) return;
+        std::lock_guard<std::mutex> kl(kilit);
+        int k = yuva[kaynak];
+        if (k != -1) listedenCikar(k);
+        else if (kayitSayisi < kapasite) {
+            k = kayitSayisi++;
+            kayitlar[k].dist = (int*) std::malloc(sizeof(int) * n);
+            kayitlar[k].parent = (int*) std::malloc(sizeof(int) * n);
+        } else {
+            k = enEski;
+            listedenCikar(k);
+            yuva[kayitlar[k].kaynak] = -1;
+            tahliye++;
+        }
+        Kayit& r = kayitlar[k];
+        r.kaynak = kaynak; r.surum = surum; r.ceza = ceza;
+        std::memcpy(r.dist, dist, sizeof(int) * n);
+        std::memcpy(r.parent, parent, sizeof(int) * n);
+        yuva[kaynak] = k;
+        basaKoy(k);
+    }
+};
+
+static YolAgaciOnbellegi yolOnbellegi;   // --onbellek <MB> ile acilir
+
+// Tek bir bas->bit sorgusu icin rotayi t.path'e yazar; aktarma cezasi verildiyse aktarma
+// duyarli motoru, on hesaplanmis tablo yukluyse tabloyu, daraltma hiyerarsisi yukluyse onu, yoksa
+// cift yonlu dijkstra'yi kullanir.
+// Onbellek aciksa tablo disindaki motorlar bas'in tum agacini kurup saklar, ayni baslangictan
+// sonraki sorgular arama yapmadan agactan cikar. Yol yoksa 0
+static int rotaBul(int bas, int bit, AramaTamponu& t) {
+    t.hatliMi = false;
+    unsigned surum = globalGraph.version();
+    int n = 0;
+    if (globalGraph.durakKapaliMi(bas) || globalGraph.durakKapaliMi(bit)) return 0;
+    if (aktarmaCezasi >= 0 && aktarmaMotoru.hazir()) {
+        t.hatliMi = true;
+        t.durumHazirla();
+        if (yolOnbellegi.hazir() && yolOnbellegi.kullan(bas, surum, aktarmaCezasi, [&](const int* d, const int* p) {
+                n = aktarmaMotoru.rotaCikar(bas, bit, d, p, t.path, t.hatlar); }))
+            return n;
+        aktarmaMotoru.agacKur(globalGraph, bas, aktarmaCezasi, t.durumDist, t.durumParent);
+        if (yolOnbellegi.hazir()) yolOnbellegi.ekle(bas, surum, aktarmaCezasi, t.durumDist, t.durumParent);
+        return aktarmaMotoru.rotaCikar(bas, bit, t.durumDist, t.durumParent, t.path, t.hatlar);
+    }
+    if (mesafeTablosu.hazir()) return mesafeTablosu.rota(bas, bit, t.path);
+    if (hiyerarsi.hazir()) return hiyerarsi.rota(bas, bit, t.hiyerarsiT, t.path, t.settled);
+    if (yolOnbellegi.hazir()) {
+        if (yolOnbellegi.kullan(bas, surum, -1, [&](const int* d, const int* p) { n = parentRotasi(d, p, bit, t.path); }))
+            return n;
+        globalGraph.dijkstra(bas, t.dist, t.parent);
+        yolOnbellegi.ekle(bas, surum, -1, t.dist, t.parent);
+        return parentRotasi(t.dist, t.parent, bit, t.path);
+    }
+    return globalGraph.dijkstraCiftYonlu(bas, bit, t.dist, t.parent, t.distB, t.parentB, t.path, t.settled);
+}
+
+// Kenar hat kumeleri: hatlar hatNoArr sirasiyla 0..hatSayisi-1 olarak yogun numaralanir ve her
+// CSR kenari icin W = ceil(hatSayisi/64) kelimelik bir bit kumesi tutulur (tek duz dizi).
+// "Bu kenar onceki hatti tasiyor mu" liste taramasi yerine tek bit testidir. hatNo -> yogun
+// indeks acik adresli bir hash'tir (hat numaralari seyrek ve buyuk olabilir). Tablo bellek
+// sinirini asarsa kurulmaz; etiketleme o zaman kenarin hat listesini tarar
+class KenarHatKumeleri {
+    int E, W;
+    unsigned long long* bit;   // E * W kelime
+    int* hatAnahtar;           // slot -> hatNo
+    int* hatYogun;             // slot -> yogun indeks, -1 = bos
+    int hatCap;                // 2'nin kuvveti
+
+    static unsigned hatHash(int hatNo) { return (unsigned) ((unsigned long long) (unsigned) hatNo * 0x9E3779B97F4A7C15ULL >> 32); }
+
+public:
+    KenarHatKumeleri(): E(0), W(0), bit(nullptr), hatAnahtar(nullptr), hatYogun(nullptr), hatCap(0) {}
+    ~KenarHatKumeleri() { kapat(); }
+
+    void kapat() {
+        std::free(bit); std::free(hatAnahtar); std::free(hatYogun);
+        bit = nullptr; hatAnahtar = hatYogun = nullptr;
+        E = W = 0; hatCap = 0;
+    }
+
+    bool hazir() const { return bit != nullptr; }
+    int kelime() const { return W; }
+    const unsigned long long* kume(int e) const { return bit + (long long) e * W; }
+
+    bool kur(const Graph& g, long long sinir) {
+        kapat();
+        if (hatSayisi <= 0 || !g.isFrozen()) return false;
+        int w = (hatSayisi + 63) / 64;
+        int cap = 16;
+        while (cap < 2 * hatSayisi) cap *= 2;
+        long long bayt = (long long) g.edgeCount() * w * sizeof(unsigned long long) + 2LL * cap * sizeof(int);
+        if (bayt > sinir) return false;
+        hatCap = cap;
+        hatAnahtar = (int*) std::malloc(sizeof(int) * hatCap);
+        hatYogun = (int*) std::malloc(sizeof(int) * hatCap);
+        for (int i = 0; i < hatCap; ++i) hatYogun[i] = -1;
+        // ayni numarali hatlarda ilki kazanir
+        for (int h = 0; h < hatSayisi; ++h) {
+            unsigned i = hatHash(hatNoArr[h]) & (hatCap - 1);
+            while (hatYogun[i] != -1 && hatAnahtar[i] != hatNoArr[h]) i = (i + 1) & (hatCap - 1);
+            if (hatYogun[i] == -1) { hatAnahtar[i] = hatNoArr[h]; hatYogun[i] = h; }
+        }
+        E = g.edgeCount(); W = w;
+        bit = (unsigned long long*) std::calloc((size_t) E * W + 1, sizeof(unsigned long long));
+        for (int e = 0; e < E; ++e) {
+            unsigned long long* k = bit + (long long) e * W;
+            for (const int* hp = g.edgeLinesBegin(e); hp != g.edgeLinesEnd(e); ++hp) {
+                int d = indeks(*hp);
+                if (d >= 0) k[d >> 6] |= 1ULL << (d & 63);
+            }
+        }
+        return true;
+    }
+
+    int indeks(int hatNo) const {
+        for (unsigned i = hatHash(hatNo) & (hatCap - 1); hatYogun[i] != -1; i = (i + 1) & (hatCap - 1))
+            if (hatAnahtar[i] == hatNo) return hatYogun[i];
+        return -1;
+    }
+
+    bool iceriyor(int e, int hatNo) const {
+        int d = indeks(hatNo);
+        return d >= 0 && (kume(e)[d >> 6] >> (d & 63) & 1ULL);
+    }
+
+};
+
+static KenarHatKumeleri kenarHatlari;
+static const long long KENAR_KUME_SINIRI = 256LL * 1024 * 1024;   // asilirsa kumeler kurulmaz
+
+// Yardimci: kenarin hat listesindeki ilk hat (yoksa -1) ve hat uyeligi; uyelik kumeler yoksa
+// kenarin hat listesi taranarak bulunur
+static int kenarIlkHat(int e) {
+    return globalGraph.edgeLinesBegin(e) != globalGraph.edgeLinesEnd(e) ? *globalGraph.edgeLinesBegin(e) : -1;
+}
+static bool kenarHattiVar(int e, int hatNo) {
+    if (kenarHatlari.hazir()) return kenarHatlari.iceriyor(e, hatNo);
+    for (const int* hp = globalGraph.edgeLinesBegin(e); hp != globalGraph.edgeLinesEnd(e); ++hp)
+        if (*hp == hatNo) return true;
+    return false;
+}
+
+// Yardimci: rota adimlarina hat etiketi ver (etiket[i] = path[i] -> path[i+1] hatti, -1 = Yok).
+// Onceki hat kenarda devam ediyorsa korunur, yoksa kenarin ilk hatti alinir; hatsiz kenar onceki
+// hatti surdurur, bastaki hatsiz kenarlar ilerideki ilk hatli kenarin hattini alir. Ileri bakis
+// bir kez sonuc vermezse tekrarlanmaz, boylece hatsiz rota da dogrusal kalir
+static void rotaEtiketle(const int* path, int pathLen, int* etiket) {
+    OLCUM_KAPSAM(Z_SORGU_ETIKET);
+    int prevLine = -1;
+    bool ileriHatYok = false;
+    for (int i = 0; i < pathLen - 1; ++i) {
+        int e = globalGraph.findEdge(path[i], path[i + 1]);
+        int hat = -1;
+        if (e != -1) hat = (prevLine != -1 && kenarHattiVar(e, prevLine)) ? prevLine : kenarIlkHat(e);
+        if (hat == -1) hat = prevLine;
+        if (hat == -1 && !ileriHatYok) {
+            for (int j = i + 1; j < pathLen - 1 && hat == -1; ++j) {
+                int ee = globalGraph.findEdge(path[j], path[j + 1]);
+                if (ee != -1) hat = kenarIlkHat(ee);
+            }
+            if (hat == -1) ileriHatYok = true;
+        }
+        etiket[i] = hat;
+        prevLine = hat;
+    }
+}
+
+// Eski etiketleme (dogrusal kenar arama, hat listesi taramasi, her adimda ileri tarama);
+// yalnizca olcum karsilastirmasi icin
+static void rotaEtiketleLineer(const int* path, int pathLen, int* etiket) {
+    int prevLine = -1;
+    for (int i = 0; i < pathLen - 1; i++) {
+        int e = globalGraph.findEdgeLineer(path[i], path[i + 1]);
+        int foundLine = -1;
+        if (e != -1 && globalGraph.edgeLinesBegin(e) != globalGraph.edgeLinesEnd(e)) {
+            if (prevLine != -1) {
+                for (const int* hp = globalGraph.edgeLinesBegin(e); hp != globalGraph.edgeLinesEnd(e); ++hp)
+                    if (*hp == prevLine) { foundLine = prevLine; break; }
+            }
+            if (foundLine == -1) foundLine = *globalGraph.edgeLinesBegin(e);
+        }
+        if (foundLine == -1 && prevLine != -1) foundLine = prevLine;
+        if (foundLine == -1) {
+            for (int j = i + 1; j < pathLen - 1; j++) {
+                int ee = globalGraph.findEdgeLineer(path[j], path[j + 1]);
+                if (ee != -1 && globalGraph.edgeLinesBegin(ee) != globalGraph.edgeLinesEnd(ee)) {
+                    foundLine = *globalGraph.edgeLinesBegin(ee); break;
+                }
+            }
+        }
+        etiket[i] = foundLine;
+        prevLine = foundLine;
+    }
+}
+
+// Yardimci: bulunan rotayi (0 tabanli dugum dizisi) hat bilgisiyle yazdir; pathLen 0 ise yol yok.
+// hatlar verilirse bolum hatlari oradan alinir, verilmezse kenar hat listelerinden tahmin edilir
+static void rotaYazdir(FILE* out, const char* adSoyad, int basID, int bitID, const int* path, int pathLen, const int* hatlar = nullptr) {
+    const char* bas_adi = (basID >= 1 && basID <= durakSayisi) ? durakAdi(basID) : "Bilinmiyor";
+    const char* bit_adi = (bitID >= 1 && bitID <= durakSayisi) ? durakAdi(bitID) : "Bilinmiyor";
+
+    std::fprintf(out, "\nYolcu: %s\nBaslangic: %s (Id: %d)\nBitis: %s (Id: %d)\n", adSoyad, bas_adi, basID, bit_adi, bitID);
+
+    if (basID < 1 || basID > durakSayisi || bitID < 1 || bitID > durakSayisi) {
+        std::fprintf(out, "  Gecersiz durak ID: basID=%d, bitID=%d\n", basID, bitID); return;
+    }
+
+    if (pathLen == 0) {
+        std::fprintf(out, "  %d'den %d'ye yol bulunamadi.\n", basID, bitID); return;
+    }
+
+    std::fprintf(out, "\nRota :\n");
+    int yerel[256];
+    int* etiket = nullptr;
+    if (!hatlar) {
+        etiket = (pathLen <= 256) ? yerel : (int*) std::malloc(sizeof(int) * pathLen);
+        rotaEtiketle(path, pathLen, etiket);
+    }
+    int prevLine = -1;
+    for (int i = 0; i < pathLen-1; i++) {
+        int u = path[i];
+        int foundLine = hatlar ? hatlar[i] : etiket[i];
+        std::fprintf(out, "%d. %s (%d) [Hat: ", i+1, durakAdi(u+1), u+1);
+        if (foundLine != -1) std::fprintf(out, "%d", foundLine); else std::fprintf(out, "Yok");
+        std::fprintf(out, "]");
+        if (foundLine != prevLine && (prevLine != -1 || (hatlar && i > 0))) { std::fprintf(out, " <<< Aktarma!"); }
+        std::fprintf(out, "\n");
+        prevLine = foundLine;
+    }
+    std::fprintf(out, "%d. %s (%d) [Hat: ", pathLen, durakAdi(path[pathLen-1]+1), path[pathLen-1]+1);
+    if (prevLine != -1) std::fprintf(out, "%d", prevLine); else std::fprintf(out, "Yok");
+    std::fprintf(out, "]\n");
+    if (etiket && etiket != yerel) std::free(etiket);
+}
+
+// CANLI GUNCELLEME (ag duzeyi)
+// Graph'taki degisiklikten sonra ona bagli yapilar da yenilenir: hat dizileri ve durak-hat indeksi
+// (hat degisikliginde), kenar hat kumeleri, aktarma motoru, tarife rotalari ve onbellegin agac boyu. On hesaplanmis
+// mesafe tablosu ve daraltma hiyerarsisi eskidiginden birakilir, rotalar yeniden aramayla cikar. Sunucu iscileri calisirken
+// cagrilacaksa agKilidi yazma icin alinmis olmali
+
+static void durakHatIndeksiniKur() {
+    durakHatIndeksi.baslat(durakSayisi);
+    for (int h = 0; h < hatSayisi; ++h)
+        for (int i = 0; i < hatDuraklari[h].size(); ++i) durakHatIndeksi.ekle(hatDuraklari[h][i], hatNoArr[h]);
+    durakHatIndeksi.sikistir();
+}
+
+// kenarlar: kenar eklendi ya da hat listeleri degisti; yapi: aktarma durumlari etkilendi
+static void guncellemeSonrasi(bool kenarlar, bool yapi) {
+    if (mesafeTablosu.hazir()) mesafeTablosu.temizle();
+    if (hiyerarsi.hazir()) hiyerarsi.temizle();
+    if (kenarlar) kenarHatlari.kur(globalGraph, KENAR_KUME_SINIRI);
+    if (tarife.hazir()) tarife.kur(globalGraph);     // bolum sureleri agirliklardan gelebilir
+    if (yapi && aktarmaMotoru.hazir()) {
+        aktarmaMotoru.kur(globalGraph);
+        yolOnbellegi.agacBoyuAyarla(aktarmaMotoru.durumSayisi() + 1);
+    }
+}
+
+bool canliDurakKapat(int durakID) {
+    if (!globalGraph.durakKapat(durakID - 1)) return false;
+    guncellemeSonrasi(false, true);
+    return true;
+}
+
+bool canliDurakAc(int durakID) {
+    if (!globalGraph.durakAc(durakID - 1)) return false;
+    guncellemeSonrasi(false, true);
+    return true;
+}
+
+// Kenar yoksa eklenir (sapma); guncellenen kenar sayisi, eklendiyse 0, gecersizse -1
+int canliKenarAyarla(int basID, int bitID, int mesafe) {
+    int n = globalGraph.kenarAyarla(basID - 1, bitID - 1, mesafe);
+    if (n == 0) guncellemeSonrasi(true, true);
+    else if (n > 0) guncellemeSonrasi(false, false);
+    return n;
+}
+
+// Yeni hat hatlar.txt'nin sonuna eklenmis gibi davranir; duraklar listede olmali
+bool canliHatEkle(int hatNo, const char* ad, const int* duraklar, int n) {
+    if (hatNo <= 0 || n < 1) return false;
+    for (int i = 0; i < n; ++i) if (!durakIsimleri.ad(duraklar[i])) return false;
+    VecArr<int> dlist;
+    VecArr<char*> isimList;
+    for (int i = 0; i < n; ++i) {
+        dlist.pushLast(duraklar[i]);
+        isimList.pushLast(const_cast<char*>(durakIsimleri.ad(duraklar[i])));
+    }
+    hatNoArr.pushLast(hatNo);
+    hatNameArr.pushLast(strKopya(ad));
+    hatDuraklari.pushLast(std::move(dlist)); hatDurakAdlari.pushLast(std::move(isimList));
+    hatSayisi++;
+    globalGraph.hatKenarlariniDegistir(duraklar, n, hatNo, true);
+    durakHatIndeksiniKur();
+    guncellemeSonrasi(true, true);
+    return true;
+}
+
+// hatNo'lu ilk hatti (HAT komutunun gosterdigi) cikarir. Adlar yukleme ya da anlik goruntu
+// havuzunu gosterebildiginden serbest birakilmaz
+bool canliHatSil(int hatNo) {
+    int idx = -1;
+    for (int i = 0; i < hatSayisi; ++i) if (hatNoArr[i] == hatNo) { idx = i; break; }
+    if (idx == -1) return false;
+    globalGraph.hatKenarlariniDegistir(hatDuraklari[idx].ptr(), hatDuraklari[idx].size(), hatNo, false);
+    hatNoArr.removeAt(idx); hatNameArr.removeAt(idx);
+    hatDuraklari.removeAt(idx); hatDurakAdlari.removeAt(idx);
+    hatSayisi--;
+    durakHatIndeksiniKur();
+    guncellemeSonrasi(true, true);
+    return true;
+}
+
+// Yardimci: yolcu satirini ayristir -> yolcuID, adSoyad, basID, bitID
+static bool yolcuSatiriAyristir(CsvOkuyucu& csv, int& yolcuID, char* adSoyad, int& basID, int& bitID) {
+    Alan a;
+    if (!csv.alan(a)) return false;
+    yolcuID = a.tamsayi();
+    if (!csv.alan(a)) return false;
+    a.kopyala(adSoyad, 256);
+    if (!csv.alan(a)) return false;
+    basID = a.tamsayi();
+    if (!csv.alan(a)) return false;
+    bitID = a.tamsayi();
+    return true;
+}
+
+// Yolcu deposu: yolcu dosyasi bir kez eslenir, yolcuID -> satir baslangici (bayt) acik adresli
+// hash tablosunda tutulur; arama O(1). Her aramadan once dosya stat edilir: buyuduyse ve
+// indekslenmis kismin parmak izi (ilk 4 KB ve son indekslenmis satirin ozeti) tutuyorsa yalnizca
+// yeni kisim taranip indekse eklenir, diger her durumda indeks bastan kurulur. Bulunan satirin
+// ID'si aranana uymazsa (dosya yerinde yeniden yazilmis) indeks yine bastan kurulur.
+// Ayni ID birden fazla satirda varsa eski dogrusal tarama gibi ilk satir kazanir
+class YolcuDeposu {
+private:
+    char yol[1024];
+    CsvOkuyucu csv;
+    long long taranan;       // indekslenmis son tam satirin sonu
+    unsigned izOzet;         // [0, taranan) parmak izi, bkz. parmakIzi()
+    long long mtimeNs;
+    ino_t inode;
+    int* anahtar;            // slot -> yolcuID, INT_MIN = bos
+    long long* konum;        // slot -> satir ofseti
+    int tabloCap;            // 2'nin kuvveti
+    int adet;
+
+    static unsigned hashle(int id) { return (unsigned) id * 2654435761u; }
+
+    void tabloyaKoy(int id, long long ofs) {
+        unsigned mask = tabloCap - 1;
+        for (unsigned i = hashle(id) & mask; ; i = (i + 1) & mask) {
+            if (anahtar[i] == INT_MIN) { anahtar[i] = id; konum[i] = ofs; adet++; return; }
+            if (anahtar[i] == id) return;
+        }
+    }
+
+    void buyut() {
+        int eskiCap = tabloCap; int* eskiA = anahtar; long long* eskiK = konum;
+        tabloCap = (tabloCap == 0) ? 1024 : tabloCap * 2;
+        anahtar = (int*) std::malloc(sizeof(int) * tabloCap);
+        konum = (long long*) std::malloc(sizeof(long long) * tabloCap);
+        for (int i = 0; i < tabloCap; ++i) anahtar[i] = INT_MIN;
+        adet = 0;
+        for (int i = 0; i < eskiCap; ++i) if (eskiA[i] != INT_MIN) tabloyaKoy(eskiA[i], eskiK[i]);
+        std::free(eskiA); std::free(eskiK);
+    }
+
+    void indeksiBosalt() {
+        std::free(anahtar); std::free(konum);
+        anahtar = nullptr; konum = nullptr; tabloCap = 0; adet = 0; taranan = 0; izOzet = 0;
+    }
+
+    // Eslenmis dosyada [0, taranan) araliginin ilk 4 KB'i ile son tam satirinin ozeti
+    unsigned parmakIzi() const {
+        if (taranan == 0 || csv.bayt() < taranan) return 0;
+        const char* v = csv.veri();
+        const char* p = v + taranan - 1;             // son satirin '\n'i
+        while (p > v && p[-1] != '\n') --p;
+        unsigned h = fnvOzet(v, taranan < 4096 ? taranan : 4096);
+        return fnvOzet(p, v + taranan - p, h);
+    }
+
+    // [taranan, dosya sonu) araligini indeksler; basliksa ilk satir atlanir
+    void tara() {
+        CsvOkuyucu parca;
+        parca.baglan(csv.veri() + taranan, csv.bayt() - taranan);
+        if (taranan == 0) parca.satir();
+        while (parca.satir()) {
+            long long ofs = taranan + parca.satirKonumu();
+            char adSoyad[256]; int id, bas, bit;
+            if (yolcuSatiriAyristir(parca, id, adSoyad, bas, bit) && id != INT_MIN) {
+                if ((adet + 1) * 2 > tabloCap) buyut();
+                tabloyaKoy(id, ofs);
+            }
+        }
+        // sonu '\n' ile bitmeyen satir bir dahaki taramada yeniden okunur (ekleme onu uzatabilir)
+        const char* son = csv.veri() + csv.bayt();
+        const char* p = son;
+        while (p > csv.veri() + taranan && p[-1] != '\n') --p;
+        taranan = p - csv.veri();
+        izOzet = parmakIzi();
+    }
+
+    // Eslenmis dosyayi bastan indeksler
+    void bastanKur() {
+        indeksiBosalt();
+        sonTaramaBayt = csv.bayt();
+        tara();
+    }
+
+public:
+    long long sonTaramaBayt;  // son yenile() cagrisinda taranan bayt (olcum icin)
+
+    YolcuDeposu(): taranan(0), izOzet(0), mtimeNs(0), inode(0), anahtar(nullptr), konum(nullptr), tabloCap(0), adet(0), sonTaramaBayt(0) { yol[0] = '\0'; }
+    ~YolcuDeposu() { indeksiBosalt(); }
+    YolcuDeposu(const YolcuDeposu&) = delete;
+    YolcuDeposu& operator=(const YolcuDeposu&) = delete;
+
+    // Dosya degismediyse hicbir sey yapmaz. Dosya acilamazsa false (errno korunur)
+    bool yenile(const char* dosya) {
+        struct stat st;
+        bool ayniDosya = std::strcmp(yol, dosya) == 0;
+        if (::stat(dosya, &st) != 0) return false;
+        long long mt = (long long) st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+        sonTaramaBayt = 0;
+        if (ayniDosya && st.st_ino == inode && (long long) st.st_size == csv.bayt() && mt == mtimeNs) return true;
+        // yalnizca sona ekleme artimli islenir: ayni dosya buyumus ve indekslenmis kisim
+        // degismemis olmali. Diger her degisiklikte bastan kur
+        bool ekleme = ayniDosya && st.st_ino == inode && (long long) st.st_size > csv.bayt();
+        if (!csv.ac(dosya)) return false;
+        std::snprintf(yol, sizeof(yol), "%s", dosya);
+        inode = st.st_ino; mtimeNs = mt;
+        if (ekleme && parmakIzi() == izOzet) {
+            sonTaramaBayt = csv.bayt() - taranan;
+            tara();
+        } else {
+            bastanKur();
+        }
+        return true;
+    }
+
+    // Satir bulunup ayristirilabildiyse true. Satirdaki ID aranana uymuyorsa indeks eskimistir
+    // (parmak izinin yakalamadigi yerinde degisiklik): bastan kurulup bir kez daha aranir
+    bool bul(int yolcuID, char* adSoyad, int& basID, int& bitID) {
+        for (int deneme = 0; deneme < 2; ++deneme) {
+            if (tabloCap == 0 || yolcuID == INT_MIN) return false;
+            unsigned mask = tabloCap - 1;
+            unsigned i = hashle(yolcuID) & mask;
+            while (anahtar[i] != INT_MIN && anahtar[i] != yolcuID) i = (i + 1) & mask;
+            if (anahtar[i] == INT_MIN) return false;
+            CsvOkuyucu satir;
+            satir.baglan(csv.veri() + konum[i], csv.bayt() - konum[i]);
+            int id;
+            if (satir.satir() && yolcuSatiriAyristir(satir, id, adSoyad, basID, bitID) && id == yolcuID) return true;
+            if (deneme == 0) bastanKur();
+        }
+        return false;
+    }
+
+    int yolcuSayisi() const { return adet; }
+};
+
+static YolcuDeposu yolcuDeposu;
+
+// Eski yontem: dosyayi bastan tarar; yalnizca olcum karsilastirmasi icin
+static bool yolcuBulLineer(CsvOkuyucu& csv, int arananYolcuID, char* adSoyad, int& basID, int& bitID) {
+    csv.bastan();
+    csv.satir();
+    while (csv.satir()) {
+        Alan a;
+        if (!csv.alan(a) || a.tamsayi() != arananYolcuID) continue;
+        csv.satirBasinaDon();
+        int yolcuID;
+        if (yolcuSatiriAyristir(csv, yolcuID, adSoyad, basID, bitID)) return true;
+    }
+    return false;
+}
+
+// === Yolcu Planla Fonksiyonu ===
+void yolcuPlanla(const char* yolcuFile, int arananYolcuID) {
+    OLCUM_KAPSAM(Z_SORGU);
+    OLCUM_BASLA(Z_SORGU_YOLCU);
+    if (!yolcuDeposu.yenile(yolcuFile)) { std::perror("yolcu_listesi.txt acilamadi"); return; }
+
+    char adSoyad[256]; int basID, bitID;
+    if (!yolcuDeposu.bul(arananYolcuID, adSoyad, basID, bitID)) { printf("Yolcu bulunamadi\n"); return; }
+    OLCUM_BITIR(Z_SORGU_YOLCU);
+
+    if (basID < 1 || basID > durakSayisi || bitID < 1 || bitID > durakSayisi) {
+        rotaYazdir(stdout, adSoyad, basID, bitID, nullptr, 0); return;
+    }
+
+    AramaTamponu t;
+    OLCUM_BASLA(Z_SORGU_ARAMA);
+    int pathLen = rotaBul(basID-1, bitID-1, t);
+    OLCUM_BITIR(Z_SORGU_ARAMA);
+    rotaYazdir(stdout, adSoyad, basID, bitID, t.path, pathLen, t.hatliMi ? t.hatlar : nullptr);
+}
+
+// === Toplu Yolcu Planlama ===
+struct YolcuKayit {
+    int yolcuID;
+    int basID;
+    int bitID;
+    int adOff;   // yolcuAdHavuzu icindeki baslangic
+};
+
+// yolcu dosyasini tek geciste okur, yolculari baslangic duragina gore gruplar,
+// her farkli baslangic icin dijkstra'yi bir kez calistirip sonuclari ciktiFile'a yazar
+void yolcuTopluPlanla(const char* yolcuFile, const char* ciktiFile) {
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+    CsvOkuyucu csv;
+    if (!csv.ac(yolcuFile)) { std::perror("yolcu_listesi.txt acilamadi"); return; }
+    FILE* out = std::fopen(ciktiFile, "w");
+    if (!out) { std::perror("cikti dosyasi acilamadi"); return; }
+
+    VecArr<YolcuKayit> kayitlar;
+    VecArr<char> adHavuzu;
+    csv.satir();
+    while (csv.satir()) {
+        YolcuKayit k; char adSoyad[256];
+        if (!yolcuSatiriAyristir(csv, k.yolcuID, adSoyad, k.basID, k.bitID)) continue;
+        k.adOff = adHavuzu.size();
+        for (int i = 0; adSoyad[i] != '\0'; ++i) adHavuzu.pushLast(adSoyad[i]);
+        adHavuzu.pushLast('\0');
+        kayitlar.pushLast(k);
+    }
+    csv.kapat();
+
+    int n = kayitlar.size();
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+    // baslangic duragina gore sayarak siralama (0 = gecersiz baslangic)
+    int* sayac = (int*) std::calloc(durakSayisi + 2, sizeof(int));
+    for (int i = 0; i < n; ++i) {
+        int b = kayitlar[i].basID;
+        sayac[(b >= 1 && b <= durakSayisi) ? b + 1 : 1]++;
+    }
+    for (int b = 1; b <= durakSayisi + 1; ++b) sayac[b] += sayac[b - 1];
+    int* sira = (int*) std::malloc(sizeof(int) * (n > 0 ? n : 1));
+    for (int i = 0; i < n; ++i) {
+        int b = kayitlar[i].basID;
+        sira[sayac[(b >= 1 && b <= durakSayisi) ? b : 0]++] = i;
+    }
+    std::free(sayac);
+
+    AramaTamponu t;
+    bool aktarmali = (aktarmaCezasi >= 0 && aktarmaMotoru.hazir());
+    int oncekiBas = -1, dijkstraSayisi = 0;
+    for (int s = 0; s < n; ++s) {
+        YolcuKayit& k = kayitlar[sira[s]];
+        bool gecerli = (k.basID >= 1 && k.basID <= durakSayisi && k.bitID >= 1 && k.bitID <= durakSayisi);
+        int pathLen = 0;
+        if (gecerli && aktarmali) {
+            if (k.basID != oncekiBas) {
+                aktarmaMotoru.agacKur(globalGraph, k.basID - 1, aktarmaCezasi, t.durumDist, t.durumParent);
+                oncekiBas = k.basID; dijkstraSayisi++;
+            }
+            pathLen = aktarmaMotoru.rotaCikar(k.basID - 1, k.bitID - 1, t.durumDist, t.durumParent, t.path, t.hatlar);
+        } else if (gecerli && mesafeTablosu.hazir()) {
+            pathLen = mesafeTablosu.rota(k.basID - 1, k.bitID - 1, t.path);
+        } else if (gecerli) {
+            if (k.basID != oncekiBas) {
+                globalGraph.dijkstra(k.basID - 1, t.dist, t.parent);
+                oncekiBas = k.basID; dijkstraSayisi++;
+            }
+            pathLen = parentRotasi(t.dist, t.parent, k.bitID - 1, t.path);
+        }
+        std::fprintf(out, "\n=== Yolcu ID: %d ===", k.yolcuID);
+        rotaYazdir(out, &adHavuzu[k.adOff], k.basID, k.bitID, t.path, pathLen, aktarmali ? t.hatlar : nullptr);
+    }
+    std::free(sira);
+
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+    double okumaMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double planMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    double toplamSn = std::chrono::duration<double>(t2 - t0).count();
+    double hiz = toplamSn > 0 ? n / toplamSn : 0.0;
+
+    FILE* hedefler[2] = { out, stdout };
+    for (int i = 0; i < 2; ++i) {
+        std::fprintf(hedefler[i], "\n--- Toplu Planlama Ozeti ---\n");
+        std::fprintf(hedefler[i], "Yolcu sayisi        : %d\n", n);
+        std::fprintf(hedefler[i], "Farkli baslangic    : %d (dijkstra cagrisi)\n", dijkstraSayisi);
+        std::fprintf(hedefler[i], "Okuma suresi        : %.2f ms\n", okumaMs);
+        std::fprintf(hedefler[i], "Planlama suresi     : %.2f ms\n", planMs);
+        std::fprintf(hedefler[i], "Verim               : %.0f yolcu/sn\n", hiz);
+    }
+    std::fclose(out);
 }
 
-// Fonksiyonlar 
-void grafOlustur(const char* durakListF, const char* hatlarF, const char* mesafeF, Graph& g);
-void durakAra(int durakID);
-void yolcuPlanla(const char* yolcuFile, int arananYolcuID);
-void tumHatlariListele();
-void hatDuraklariGoster(int hatNo);
 
-// GRAFI OLUSTUR 
-void grafOlustur(const char* durakListF, const char* hatlarF, const char* mesafeF, Graph& g) {
-    // durak_listesi.txt oku
-    FILE* fDurak = std::fopen(durakListF, "r");
-    if (!fDurak) {
-        std::perror("durak_listesi.txt acilamadi");
-        std::exit(1);
+// === Sorgu Sunucusu ===
+// Isciler yalnizca kendi dist/parent tamponlarina yazar; sorgular agKilidi'ni okuma icin
+// paylasir ve birlikte calisir, guncelleme komutlari yazma icin tek basina alir.
+//
+// Protokol (satir basina bir istek, her cevap "." satiri ile biter):
+//   PLAN <basID> <bitID>    yolculuk plani
+//   DURAK <durakID>         durak ve gectigi hatlar
+//   ARA <durak adi>         isimle durak arama
+//   HAT <hatNo>             hattin duraklari
+//   HATLAR                  tum hatlar
+//   KAPAT <durakID> / AC <durakID>        duragi kapat / yeniden ac
+//   MESAFE <basID> <bitID> <mesafe>       kenar agirligi (kenar yoksa eklenir)
+//   HATEKLE <hatNo> <id,id,...> [ad]      yeni hat / HATSIL <hatNo>
+
+// Okuyucu-yazici kilidi: okuyucular birlikte girer, yazici tek basina. Bekleyen yazici varken
+// yeni okuyucu alinmaz (surekli sorgu akisi guncellemeyi bekletmesin)
+class OkumaYazmaKilidi {
+private:
+    std::mutex m;
+    std::condition_variable cv;
+    int okuyan;
+    int bekleyenYazici;
+    bool yaziyor;
+
+public:
+    OkumaYazmaKilidi(): okuyan(0), bekleyenYazici(0), yaziyor(false) {}
+
+    void okumaAl() {
+        std::unique_lock<std::mutex> kilit(m);
+        while (yaziyor || bekleyenYazici > 0) cv.wait(kilit);
+        okuyan++;
     }
-    char line[16000];
-    std::fgets(line, sizeof(line), fDurak);
 
-    int durakSatirCount = 0;
-    while (std::fgets(line, sizeof(line), fDurak)) {
-        bool only_ws = true;
-        for (int i = 0; line[i] != '\0'; ++i)
-            if (line[i] != ' ' && line[i] != '\t' && line[i] != '\n' && line[i] != '\r') { only_ws = false; break; }
-        if (only_ws) continue;
+    void okumaBirak() {
+        std::lock_guard<std::mutex> kilit(m);
+        if (--okuyan == 0) cv.notify_all();
+    }
 
-        char* token = std::strtok(line, ",");
-        if (!token) continue;
-        int id = std::atoi(token);
-        if (id < 1 || id > MAX_DURAK) continue;
-
-        token = std::strtok(nullptr, ",");
-        if (!token) continue;
-        while (*token == ' ' || *token == '\t' || *token == '\n' || *token == '\r') ++token;
-        int len = std::strlen(token);
-        while (len > 0 && (token[len - 1] == ' ' || token[len - 1] == '\t' || token[len - 1] == '\n' || token[len - 1] == '\r')) token[--len] = '\0';
-        std::strncpy(durakNameArr[id], token, 256);
-        durakNameArr[id][255] = '\0';
-        durakSatirCount++;
+    void yazmaAl() {
+        std::unique_lock<std::mutex> kilit(m);
+        bekleyenYazici++;
+        while (yaziyor || okuyan > 0) cv.wait(kilit);
+        bekleyenYazici--;
+        yaziyor = true;
     }
-    std::fclose(fDurak);
 
-    // hatlar.txt oku
-    FILE* fHat = std::fopen(hatlarF, "r");
-    if (!fHat) { std::perror("hatlar.txt acilamadi"); std::exit(1); }
-    std::fgets(line, sizeof(line), fHat);
+    void yazmaBirak() {
+        std::lock_guard<std::mutex> kilit(m);
+        yaziyor = false;
+        cv.notify_all();
+    }
+};
 
-    int hatSatirCount = 0; hatSayisi = 0;
-    while (std::fgets(line, sizeof(line), fHat)) {
-        bool only_ws = true;
-        for (int i = 0; line[i] != '\0'; ++i)
-            if (line[i] != ' ' && line[i] != '\t' && line[i] != '\n' && line[i] != '\r') { only_ws = false; break; }
-        if (only_ws) continue;
+static OkumaYazmaKilidi agKilidi;
 
-        char* token = std::strtok(line, ",");
-        if (!token) continue;
-        int hatNo = std::atoi(token);
-        if (hatNo <= 0) continue;
+// Cevaplari istek sirasiyla yazan cikis (stdout veya bir soket baglantisi). Yalnizca
+// [sonraki, toplam) penceresi halka tamponda tutulur; pencere dolunca halka iki katina cikar.
+// Karsi taraf baglantiyi kapattiysa (EPIPE vb.) kalan cevaplar yazilmadan atilir
+class SiraliCikis {
+private:
+    int fd;
+    bool fdKapat;
+    std::mutex m;
+    long long sonraki;       // yazilmayi bekleyen ilk sira
+    long long toplam;        // bu cikisa gelen istek sayisi
+    bool okumaBitti;
+    bool kopuk;              // yazma hata verdi, baglanti gitti
+    char** bekleyen;         // sira & (halkaCap-1) -> cevap (nullptr = hazir degil)
+    size_t* uzunluk;
+    long long halkaCap;      // 2'nin kuvveti
 
-        if (hatSayisi >= MAX_HAT) break;
-        hatNoArr[hatSayisi] = hatNo;
+    // hepsi yazildiysa true; hata (EPIPE dahil) durumunda false
+    static bool hepsiniYaz(int fd, const char* p, size_t n) {
+        while (n > 0) {
+            ssize_t w = ::write(fd, p, n);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) return false;
+            p += w; n -= (size_t) w;
+        }
+        return true;
+    }
 
-        token = std::strtok(nullptr, ",");
-        if (!token) { hatNameArr[hatSayisi][0] = '\0'; }
-        else {
-            while (*token == ' ' || *token == '\t' || *token == '\n' || *token == '\r') ++token;
-            int len2 = std::strlen(token);
-            while (len2 > 0 && (token[len2 - 1] == ' ' || token[len2 - 1] == '\t' || token[len2 - 1] == '\n' || token[len2 - 1] == '\r')) token[--len2] = '\0';
-            std::strncpy(hatNameArr[hatSayisi], token, 256); hatNameArr[hatSayisi][255] = '\0';
+    void halkaBuyut() {
+        long long yeniCap = halkaCap * 2;
+        char** b = (char**) std::malloc(sizeof(char*) * yeniCap);
+        size_t* u = (size_t*) std::malloc(sizeof(size_t) * yeniCap);
+        for (long long s = sonraki; s < toplam; ++s) {
+            b[s & (yeniCap - 1)] = bekleyen[s & (halkaCap - 1)];
+            u[s & (yeniCap - 1)] = uzunluk[s & (halkaCap - 1)];
         }
+        std::free(bekleyen); std::free(uzunluk);
+        bekleyen = b; uzunluk = u; halkaCap = yeniCap;
+    }
 
-        VecArr<int> dlist;
-        VecArr<char*> isimList;
-        while ((token = std::strtok(nullptr, ",")) != nullptr) {
-            while (*token == ' ' || *token == '\t' || *token == '\n' || *token == '\r') ++token;
-            int len2 = std::strlen(token);
-            while (len2 > 0 && (token[len2 - 1] == ' ' || token[len2 - 1] == '\t' || token[len2 - 1] == '\n' || token[len2 - 1] == '\r')) token[--len2] = '\0';
-            if (len2 == 0) continue;
+    // kilit altinda cagrilir; baglanti bittiyse true
+    bool bittiMi() const { return okumaBitti && sonraki == toplam; }
+
+public:
+    SiraliCikis(int f, bool kapat): fd(f), fdKapat(kapat), sonraki(0), toplam(0), okumaBitti(false), kopuk(false), halkaCap(64) {
+        bekleyen = (char**) std::malloc(sizeof(char*) * halkaCap);
+        uzunluk = (size_t*) std::malloc(sizeof(size_t) * halkaCap);
+    }
+    ~SiraliCikis() {
+        for (long long s = sonraki; s < toplam; ++s) std::free(bekleyen[s & (halkaCap - 1)]);
+        std::free(bekleyen); std::free(uzunluk);
+        if (fdKapat) ::close(fd);
+    }
+    SiraliCikis(const SiraliCikis&) = delete;
+    SiraliCikis& operator=(const SiraliCikis&) = delete;
+
+    long long siraAl() {
+        std::lock_guard<std::mutex> kilit(m);
+        if (toplam - sonraki == halkaCap) halkaBuyut();
+        bekleyen[toplam & (halkaCap - 1)] = nullptr;
+        return toplam++;
+    }
 
-            char* copyName = (char*) std::malloc(len2 + 1); std::strcpy(copyName, token); isimList.pushLast(copyName);
-            int durakID = findDurakIDbyName(token);
-            if (durakID != -1) { dlist.pushLast(durakID); durakHatAgaci.insert(durakID, hatNo); }
+    // cevabi sahiplenir; cikis tamamen bittiyse true doner (cagiran silebilir)
+    bool yaz(long long sira, char* cevap, size_t n) {
+        std::lock_guard<std::mutex> kilit(m);
+        bekleyen[sira & (halkaCap - 1)] = cevap; uzunluk[sira & (halkaCap - 1)] = n;
+        while (sonraki < toplam && bekleyen[sonraki & (halkaCap - 1)]) {
+            long long i = sonraki & (halkaCap - 1);
+            if (!kopuk && !hepsiniYaz(fd, bekleyen[i], uzunluk[i])) kopuk = true;
+            std::free(bekleyen[i]);
+            sonraki++;
         }
-        hatDuraklari.pushLast(dlist); hatDurakAdlari.pushLast(isimList);
-        hatSayisi++; hatSatirCount++;
+        return bittiMi();
     }
-    std::fclose(fHat);
 
-    // durak_mesafeleri.txt oku 
-    FILE* fMesafe = std::fopen(mesafeF, "r");
-    if (!fMesafe) { std::perror("durak_mesafeleri.txt acilamadi"); std::exit(1); }
-    int row = 0;
-    while (std::fgets(line, sizeof(line), fMesafe)) {
+    bool okumaBitir() {
+        std::lock_guard<std::mutex> kilit(m);
+        okumaBitti = true;
+        return bittiMi();
+    }
+};
+
+struct SorguIsi {
+    long long sira;
+    char* metin;
+    SiraliCikis* cikis;
+};
+
+// Kilitli FIFO is kuyrugu
+class IsKuyrugu {
+private:
+    std::mutex m;
+    std::condition_variable cv;
+    VecArr<SorguIsi> isler;
+    int bas;
+    bool kapali;
+
+public:
+    IsKuyrugu(): bas(0), kapali(false) {}
+
+    void ekle(const SorguIsi& is) {
+        {
+            std::lock_guard<std::mutex> kilit(m);
+            isler.pushLast(is);
+        }
+        cv.notify_one();
+    }
+
+    // kuyruk kapali ve bos ise false
+    bool al(SorguIsi& is) {
+        std::unique_lock<std::mutex> kilit(m);
+        while (bas == isler.size() && !kapali) cv.wait(kilit);
+        if (bas == isler.size()) return false;
+        is = isler[bas++];
+        if (bas == isler.size()) { isler = VecArr<SorguIsi>(); bas = 0; }
+        return true;
+    }
+
+    void kapat() {
+        {
+            std::lock_guard<std::mutex> kilit(m);
+            kapali = true;
+        }
+        cv.notify_all();
+    }
+};
+
+// Tek bir istek satirini cevaplar; t cagirana ait karalama tamponlari
+static void sorguCevapla(FILE* out, char* istek, AramaTamponu& t) {
+    int n = std::strlen(istek);
+    while (n > 0 && (istek[n - 1] == '\n' || istek[n - 1] == '\r' || istek[n - 1] == ' ')) istek[--n] = '\0';
+    char* p = istek;
+    while (*p == ' ' || *p == '\t') ++p;
+    char* arg = p;
+    while (*arg && *arg != ' ' && *arg != '\t') ++arg;
+    if (*arg) *arg++ = '\0';
+    while (*arg == ' ' || *arg == '\t') ++arg;
+
+    bool yazma = std::strcmp(p, "KAPAT") == 0 || std::strcmp(p, "AC") == 0 || std::strcmp(p, "MESAFE") == 0
+                 || std::strcmp(p, "HATEKLE") == 0 || std::strcmp(p, "HATSIL") == 0;
+    if (yazma) agKilidi.yazmaAl(); else agKilidi.okumaAl();
+
+    if (std::strcmp(p, "PLAN") == 0) {
+        OLCUM_KAPSAM(Z_SORGU);
+        int basID = 0, bitID = 0;
+        if (std::sscanf(arg, "%d %d", &basID, &bitID) != 2) { std::fprintf(out, "HATA: PLAN <basID> <bitID>\n"); }
+        else if (basID < 1 || basID > durakSayisi || bitID < 1 || bitID > durakSayisi) {
+            rotaYazdir(out, "-", basID, bitID, nullptr, 0);
+        } else {
+            OLCUM_BASLA(Z_SORGU_ARAMA);
+            int pathLen = rotaBul(basID - 1, bitID - 1, t);
+            OLCUM_BITIR(Z_SORGU_ARAMA);
+            rotaYazdir(out, "-", basID, bitID, t.path, pathLen, t.hatliMi ? t.hatlar : nullptr);
+        }
+    }
+    else if (std::strcmp(p, "SEFER") == 0) {
+        int basID = 0, bitID = 0, okunan = 0;
+        char saat[16];
+        int kalkis = (std::sscanf(arg, "%d %d %15s%n", &basID, &bitID, saat, &okunan) == 3) ? saatAyristir(saat, std::strlen(saat)) : -1;
+        if (kalkis < 0) std::fprintf(out, "HATA: SEFER <basID> <bitID> <SS:DD>\n");
+        else if (!tarife.hazir()) std::fprintf(out, "Tarife yuklu degil (--tarife <dosya>)\n");
+        else if (basID < 1 || basID > durakSayisi || bitID < 1 || bitID > durakSayisi)
+            std::fprintf(out, "  Gecersiz durak ID: basID=%d, bitID=%d\n", basID, bitID);
+        else seferYazdir(out, basID, bitID, kalkis, t.sefer);
+    }
+    else if (std::strcmp(p, "DURAK") == 0) { durakAra(std::atoi(arg), out); }
+    else if (std::strcmp(p, "ARA") == 0) {
+        int id = findDurakIDbyName(arg);
+        if (id == -1) std::fprintf(out, "Durak '%s' bulunamadi.\n", arg);
+        else durakAra(id, out);
+    }
+    else if (std::strcmp(p, "HAT") == 0) { hatDuraklariGoster(std::atoi(arg), out); }
+    else if (std::strcmp(p, "HATLAR") == 0) { tumHatlariListele(out); }
+    else if (std::strcmp(p, "ONBELLEK") == 0) {
+        if (yolOnbellegi.hazir()) yolOnbellegi.istatistikYaz(out);
+        else std::fprintf(out, "Onbellek kapali (--onbellek <MB>)\n");
+    }
+    else if (std::strcmp(p, "ISTATISTIK") == 0) {
+        if (std::strcmp(arg, "SIFIRLA") == 0) { olcumSifirla(); std::fprintf(out, "Olcum sayaclari sifirlandi\n"); }
+        else olcumRaporuYaz(out);
+    }
+    else if (std::strcmp(p, "KAPAT") == 0 || std::strcmp(p, "AC") == 0) {
+        int id = std::atoi(arg);
+        bool kapat = (p[0] == 'K');
+        if (kapat ? canliDurakKapat(id) : canliDurakAc(id)) std::fprintf(out, "Durak %d %s\n", id, kapat ? "kapatildi" : "acildi");
+        else std::fprintf(out, "HATA: durak %d %s\n", id, kapat ? "gecersiz ya da zaten kapali" : "kapali degil");
+    }
+    else if (std::strcmp(p, "MESAFE") == 0) {
+        int basID = 0, bitID = 0, mesafe = 0;
+        int degisen = (std::sscanf(arg, "%d %d %d", &basID, &bitID, &mesafe) == 3) ? canliKenarAyarla(basID, bitID, mesafe) : -1;
+        if (degisen < 0) std::fprintf(out, "HATA: MESAFE <basID> <bitID> <mesafe>\n");
+        else if (degisen == 0) std::fprintf(out, "Kenar %d-%d eklendi (%d)\n", basID, bitID, mesafe);
+        else std::fprintf(out, "Kenar %d-%d: %d yon guncellendi (%d)\n", basID, bitID, degisen, mesafe);
+    }
+    else if (std::strcmp(p, "HATEKLE") == 0) {
+        // HATEKLE <hatNo> <id,id,...> [ad]
+        char* q = arg;
+        int hatNo = (int) std::strtol(q, &q, 10);
+        while (*q == ' ' || *q == '\t') ++q;
+        VecArr<int> duraklar;
+        while (*q >= '0' && *q <= '9') {
+            duraklar.pushLast((int) std::strtol(q, &q, 10));
+            if (*q == ',') ++q;
+        }
+        while (*q == ' ' || *q == '\t') ++q;
+        if (canliHatEkle(hatNo, q, duraklar.ptr(), duraklar.size()))
+            std::fprintf(out, "Hat %d eklendi (%d durak)\n", hatNo, duraklar.size());
+        else std::fprintf(out, "HATA: HATEKLE <hatNo> <durakID,durakID,...> [ad]\n");
+    }
+    else if (std::strcmp(p, "HATSIL") == 0) {
+        int hatNo = std::atoi(arg);
+        if (canliHatSil(hatNo)) std::fprintf(out, "Hat %d silindi\n", hatNo);
+        else std::fprintf(out, "HATA: hat %d yok\n", hatNo);
+    }
+    else if (*p) { std::fprintf(out, "HATA: bilinmeyen komut '%s'\n", p); }
+    if (yazma) agKilidi.yazmaBirak(); else agKilidi.okumaBirak();
+    std::fprintf(out, ".\n");
+}
+
+static void sunucuIscisi(IsKuyrugu* kuyruk) {
+    AramaTamponu t;
+    SorguIsi is;
+    while (kuyruk->al(is)) {
+        char* buf = nullptr; size_t n = 0;
+        FILE* out = open_memstream(&buf, &n);
+        sorguCevapla(out, is.metin, t);
+        std::fclose(out);
+        std::free(is.metin);
+        if (is.cikis->yaz(is.sira, buf, n)) delete is.cikis;
+    }
+}
+
+// Bir kaynaktan (stdin veya soket) satirlari okuyup kuyruga ekler; okunan istek sayisini doner
+static long long istekleriOku(int fd, SiraliCikis* cikis, IsKuyrugu* kuyruk) {
+    FILE* in = ::fdopen(::dup(fd), "r");
+    if (!in) return 0;
+    char* line = nullptr; size_t lineCap = 0;
+    long long adet = 0;
+    while (getline(&line, &lineCap, in) != -1) {
         bool only_ws = true;
         for (int i = 0; line[i] != '\0'; ++i)
             if (line[i] != ' ' && line[i] != '\t' && line[i] != '\n' && line[i] != '\r') { only_ws = false; break; }
-        if (only_ws) { row++; continue; }
-        int col = 0;
-        char* token = std::strtok(line, ",");
-        while (token) {
-            while (*token == ' ' || *token == '\t' || *token == '\n' || *token == '\r') ++token;
-            int len2 = std::strlen(token);
-            while (len2 > 0 && (token[len2 - 1] == ' ' || token[len2 - 1] == '\t' || token[len2 - 1] == '\n' || token[len2 - 1] == '\r')) token[--len2] = '\0';
-            if (*token && std::strcmp(token, "-") != 0) {
-                int w = std::atoi(token); int u = row; int v = col;
-                if (u >= 0 && u < MAX_DURAK && v >= 0 && v < MAX_DURAK) g.addEdge(u, v, w);
-            }
-            token = std::strtok(nullptr, ","); col++;
+        if (only_ws) continue;
+        SorguIsi is;
+        is.sira = cikis->siraAl();
+        is.metin = strKopya(line);
+        is.cikis = cikis;
+        kuyruk->ekle(is);
+        adet++;
+    }
+    std::free(line);
+    std::fclose(in);
+    return adet;
+}
+
+static void baglantiOkuyucu(int fd, IsKuyrugu* kuyruk) {
+    SiraliCikis* cikis = new SiraliCikis(fd, true);
+    istekleriOku(fd, cikis, kuyruk);
+    if (cikis->okumaBitir()) delete cikis;
+}
+
+// soketYolu nullptr ise stdin/stdout, degilse Unix soketi uzerinden hizmet verir
+void sunucuCalistir(const char* soketYolu, int isciSayisi) {
+    if (isciSayisi < 1) isciSayisi = 1;
+    ::signal(SIGPIPE, SIG_IGN);     // kapanan baglantiya yazma surec yerine yalnizca o baglantiyi bitirir
+    IsKuyrugu kuyruk;
+    VecArr<std::thread*> isciler;
+    for (int i = 0; i < isciSayisi; ++i) isciler.pushLast(new std::thread(sunucuIscisi, &kuyruk));
+
+    if (!soketYolu) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        SiraliCikis* cikis = new SiraliCikis(1, false);
+        long long adet = istekleriOku(0, cikis, &kuyruk);
+        kuyruk.kapat();
+        for (int i = 0; i < isciler.size(); ++i) { isciler[i]->join(); delete isciler[i]; }
+        delete cikis;
+        double sn = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        std::fprintf(stderr, "Sunucu: %lld istek, %d isci, %.2f ms, %.0f istek/sn\n", adet, isciSayisi, sn * 1000.0, sn > 0 ? adet / sn : 0.0);
+        return;
+    }
+
+    int dinleyici = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (dinleyici < 0) { std::perror("socket"); std::exit(1); }
+    sockaddr_un adres;
+    std::memset(&adres, 0, sizeof(adres));
+    adres.sun_family = AF_UNIX;
+    std::strncpy(adres.sun_path, soketYolu, sizeof(adres.sun_path) - 1);
+    ::unlink(soketYolu);
+    if (::bind(dinleyici, (sockaddr*) &adres, sizeof(adres)) < 0 || ::listen(dinleyici, 64) < 0) {
+        std::perror(soketYolu); std::exit(1);
+    }
+    std::fprintf(stderr, "Sunucu %s uzerinde dinliyor (%d isci)\n", soketYolu, isciSayisi);
+    while (true) {
+        int fd = ::accept(dinleyici, nullptr, nullptr);
+        if (fd < 0) continue;
+        std::thread(baglantiOkuyucu, fd, &kuyruk).detach();
+    }
+}
+
+// === Sentetik Ag Uretici ===
+// Tohumlu xorshift; ayni tohum her zaman ayni agi uretir
+struct Rastgele {
+    unsigned long long x;
+    Rastgele(unsigned long long tohum): x(tohum ? tohum : 88172645463325252ULL) {}
+    unsigned long long sonraki() { x ^= x << 13; x ^= x >> 7; x ^= x << 17; return x; }
+    int aralik(int lo, int hi) { return lo + (int) (sonraki() % (unsigned long long) (hi - lo + 1)); }
+};
+
+// Yardimci: klasor + dosya adi
+static void yolBirlestir(char* hedef, int boyut, const char* klasor, const char* ad) {
+    std::snprintf(hedef, boyut, "%s/%s", klasor, ad);
+}
+
+// Duraklar kareye yakin bir izgaraya dizilir, komsu izgara noktalari arasinda kenar vardir.
+// Hatlar izgara kenarlari uzerinde rastgele yuruyuslerdir. Dort girdi dosyasini da uretir.
+void sentetikAgUret(int durakN, int hatN, int yolcuN, unsigned long long tohum, const char* klasor) {
+    if (durakN < 2) durakN = 2;
+    if (hatN < 1) hatN = 1;
+    Rastgele rng(tohum);
+    int genislik = 1;
+    while (genislik * genislik < durakN) genislik++;
+    char yol[1024];
+
+    yolBirlestir(yol, sizeof(yol), klasor, "durak_listesi.txt");
+    FILE* f = std::fopen(yol, "w");
+    if (!f) { std::perror(yol); return; }
+    std::fprintf(f, "durakID,durakAdi\n");
+    for (int i = 1; i <= durakN; ++i) std::fprintf(f, "%d,Durak %d\n", i, i);
+    std::fclose(f);
+
+    // kenar agirliklari: sag (i, i+1) ve alt (i, i+genislik) komsu icin
+    int* sagW = (int*) std::malloc(sizeof(int) * durakN);
+    int* altW = (int*) std::malloc(sizeof(int) * durakN);
+    for (int i = 0; i < durakN; ++i) {
+        sagW[i] = ((i % genislik) + 1 < genislik && i + 1 < durakN) ? rng.aralik(1, 20) : 0;
+        altW[i] = (i + genislik < durakN) ? rng.aralik(1, 20) : 0;
+    }
+
+    yolBirlestir(yol, sizeof(yol), klasor, "hatlar.txt");
+    f = std::fopen(yol, "w");
+    if (!f) { std::perror(yol); std::free(sagW); std::free(altW); return; }
+    std::fprintf(f, "hatNo,hatAdi,duraklar\n");
+    for (int h = 1; h <= hatN; ++h) {
+        int uzunluk = rng.aralik(5, 40);
+        int cur = rng.aralik(0, durakN - 1), onceki = -1;
+        std::fprintf(f, "%d,Hat %d,Durak %d", h, h, cur + 1);
+        for (int k = 1; k < uzunluk; ++k) {
+            int aday[4], n = 0;
+            if (sagW[cur]) aday[n++] = cur + 1;
+            if (cur % genislik > 0 && sagW[cur - 1]) aday[n++] = cur - 1;
+            if (altW[cur]) aday[n++] = cur + genislik;
+            if (cur >= genislik) aday[n++] = cur - genislik;
+            int secilen = -1;
+            for (int deneme = 0; deneme < 4 && n > 0; ++deneme) {
+                int a = aday[rng.aralik(0, n - 1)];
+                if (a != onceki) { secilen = a; break; }
+            }
+            if (secilen < 0) break;
+            onceki = cur; cur = secilen;
+            std::fprintf(f, ",Durak %d", cur + 1);
         }
-        row++;
+        std::fprintf(f, "\n");
     }
-    std::fclose(fMesafe);
+    std::fclose(f);
 
-    // Hat bazli durak dizisinden graf kenarina hatNo ekle
-    for (int h = 0; h < hatSayisi; ++h) {
-        int hatNo = hatNoArr[h];
-        VecArr<int>& dlist = hatDuraklari[h];
-        for (int i = 0; i + 1 < dlist.size(); ++i) {
-            int u = dlist[i] - 1; int v = dlist[i + 1] - 1;
-            g.addLineToEdge(u, v, hatNo);
+    // kenar listesi: matrisle ayni kenarlar ayni sirada, dosya O(E)
+    if (kenarListesiZorla) {
+        yolBirlestir(yol, sizeof(yol), klasor, "durak_mesafeleri.txt");
+        f = std::fopen(yol, "w");
+        if (!f) { std::perror(yol); std::free(sagW); std::free(altW); return; }
+        std::fprintf(f, "u,v,mesafe\n");
+        for (int i = 0; i < durakN; ++i) {
+            if (sagW[i]) std::fprintf(f, "%d,%d,%d\n", i + 1, i + 2, sagW[i]);
+            if (altW[i]) std::fprintf(f, "%d,%d,%d\n", i + 1, i + genislik + 1, altW[i]);
+        }
+        std::fclose(f);
+    }
+    else {
+        // yogun matris: her kenar ust ucgende bir kez yazilir (yukleyici iki yonu de ekler)
+        if (durakN > 20000) printf("UYARI: %d durak icin mesafe matrisi ~%.1f GB olacak\n", durakN, 2.0 * durakN * (double) durakN / 1e9);
+        yolBirlestir(yol, sizeof(yol), klasor, "durak_mesafeleri.txt");
+        f = std::fopen(yol, "w");
+        if (!f) { std::perror(yol); std::free(sagW); std::free(altW); return; }
+        char* satir = (char*) std::malloc(2 * durakN + 32);
+        char sayi[16];
+        for (int i = 0; i < durakN; ++i) {
+            int p = 0;
+            for (int j = 0; j < durakN; ++j) {
+                if (j) satir[p++] = ',';
+                int w = 0;
+                if (j == i + 1) w = sagW[i];
+                else if (j == i + genislik) w = altW[i];
+                if (w) {
+                    std::fwrite(satir, 1, p, f); p = 0;
+                    int n = std::snprintf(sayi, sizeof(sayi), "%d", w);
+                    std::fwrite(sayi, 1, n, f);
+                } else {
+                    satir[p++] = '-';
+                }
+                if (p > 2 * durakN) { std::fwrite(satir, 1, p, f); p = 0; }
+            }
+            satir[p++] = '\n';
+            std::fwrite(satir, 1, p, f);
         }
+        std::free(satir);
+        std::fclose(f);
     }
+    std::free(sagW); std::free(altW);
+
+    yolBirlestir(yol, sizeof(yol), klasor, "yolcu_listesi.txt");
+    f = std::fopen(yol, "w");
+    if (!f) { std::perror(yol); return; }
+    std::fprintf(f, "yolcuID,adSoyad,basID,bitID\n");
+    for (int y = 1; y <= yolcuN; ++y)
+        std::fprintf(f, "%d,Yolcu %d,%d,%d\n", y, y, rng.aralik(1, durakN), rng.aralik(1, durakN));
+    std::fclose(f);
+
+    printf("Sentetik ag uretildi: %d durak, %d hat, %d yolcu -> %s/\n", durakN, hatN, yolcuN, klasor);
 }
 
-// Durak Ara 
-void durakAra(int durakID) {
-    if (durakID < 1 || durakID > MAX_DURAK) {
-        printf("HATA: Geçersiz durakID=%d\n", durakID); return;
+// === Performans Olcumleri ===
+// Yardimci: iki zaman noktasi arasindaki sure (ms)
+static double gecenMs(std::chrono::steady_clock::time_point bas, std::chrono::steady_clock::time_point bit) {
+    return std::chrono::duration<double, std::milli>(bit - bas).count();
+}
+
+// Bagli liste ve CSR dijkstra'yi tum kaynaklardan calistirip saniyedeki gevsetme sayisini karsilastirir
+void benchCSR(int tekrar) {
+    if (!globalGraph.listeVar()) { printf("Bagli liste yok (ag anlik goruntuden acildi); --ag olmadan calistirin.\n"); return; }
+    int V = globalGraph.vertexCount();
+    int E = globalGraph.edgeCount();
+    int* dist = (int*) std::malloc(sizeof(int) * V);
+    int* parent = (int*) std::malloc(sizeof(int) * V);
+    long long kontrolListe = 0, kontrolCSR = 0;
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < tekrar; ++r)
+        for (int s = 0; s < V; ++s) { globalGraph.dijkstraListe(s, dist, parent); kontrolListe += parent[(s + 1) % V]; }
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < tekrar; ++r)
+        for (int s = 0; s < V; ++s) { globalGraph.dijkstra(s, dist, parent); kontrolCSR += parent[(s + 1) % V]; }
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+
+    // her tam dijkstra tum dugumleri cikarir, yani her yonlu kenar bir kez gevsetilir
+    double gevsetme = (double) E * V * tekrar;
+    double msListe = gecenMs(t0, t1), msCSR = gecenMs(t1, t2);
+    printf("\n--- CSR Karsilastirmasi (V=%d, E=%d, %d x %d dijkstra) ---\n", V, E, tekrar, V);
+    printf("Bagli liste : %10.2f ms  %12.0f gevsetme/sn\n", msListe, msListe > 0 ? gevsetme / (msListe / 1000.0) : 0.0);
+    printf("CSR         : %10.2f ms  %12.0f gevsetme/sn\n", msCSR, msCSR > 0 ? gevsetme / (msCSR / 1000.0) : 0.0);
+    if (msCSR > 0) printf("Hizlanma    : %.2fx\n", msListe / msCSR);
+    if (kontrolListe != kontrolCSR) printf("UYARI: iki yerlesim farkli sonuc verdi!\n");
+    std::free(dist); std::free(parent);
+}
+
+// hatlar.txt'deki tum durak tokenlarini dogrusal tarama ve hash indeksi ile cozer
+void benchIsim(int tekrar) {
+    long long token = 0, kontrolLineer = 0, kontrolHash = 0;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < tekrar; ++r)
+        for (int h = 0; h < hatDurakAdlari.size(); ++h)
+            for (int i = 0; i < hatDurakAdlari[h].size(); ++i) { kontrolLineer += findDurakIDbyNameLineer(hatDurakAdlari[h][i]); token++; }
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < tekrar; ++r)
+        for (int h = 0; h < hatDurakAdlari.size(); ++h)
+            for (int i = 0; i < hatDurakAdlari[h].size(); ++i) kontrolHash += findDurakIDbyName(hatDurakAdlari[h][i]);
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+
+    double msLineer = gecenMs(t0, t1), msHash = gecenMs(t1, t2);
+    printf("\n--- Durak Ismi Arama (%d durak, %lld token) ---\n", durakSayisi, token);
+    printf("Dogrusal strcmp : %10.2f ms  %10.1f ns/arama\n", msLineer, token ? msLineer * 1e6 / token : 0.0);
+    printf("Hash indeksi    : %10.2f ms  %10.1f ns/arama\n", msHash, token ? msHash * 1e6 / token : 0.0);
+    if (msHash > 0) printf("Hizlanma        : %.1fx\n", msLineer / msHash);
+    if (kontrolLineer != kontrolHash) printf("UYARI: iki arama farkli sonuc verdi!\n");
+}
+
+// Rastgele PLAN isteklerini 1, 2, 4, ... isci ile sunucu havuzundan gecirip verimi olcer
+void benchSunucu(int tekrar) {
+    int istekSayisi = tekrar * 100;
+    int enCok = (int) std::thread::hardware_concurrency();
+    if (enCok < 1) enCok = 1;
+    Rastgele rng(42);
+    VecArr<char*> istekler;
+    for (int i = 0; i < istekSayisi; ++i) {
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "PLAN %d %d", rng.aralik(1, durakSayisi), rng.aralik(1, durakSayisi));
+        istekler.pushLast(strKopya(buf));
     }
-    BSTNode* node = durakHatAgaci.search(durakID);
-    if (!node) {
-        printf("Durak ID %d bulunamadi.\n", durakID); return;
+    int bosCikis = ::open("/dev/null", O_WRONLY);
+    printf("\n--- Sunucu Verimi (%d PLAN istegi, %d cekirdek) ---\n", istekSayisi, enCok);
+    double tekIsciMs = 0;
+    for (int isci = 1; ; isci *= 2) {
+        if (isci > enCok) isci = enCok;
+        IsKuyrugu kuyruk;
+        SiraliCikis* cikis = new SiraliCikis(bosCikis, false);
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        VecArr<std::thread*> isciler;
+        for (int i = 0; i < isci; ++i) isciler.pushLast(new std::thread(sunucuIscisi, &kuyruk));
+        for (int i = 0; i < istekSayisi; ++i) {
+            SorguIsi is; is.sira = cikis->siraAl(); is.metin = strKopya(istekler[i]); is.cikis = cikis;
+            kuyruk.ekle(is);
+        }
+        kuyruk.kapat();
+        for (int i = 0; i < isciler.size(); ++i) { isciler[i]->join(); delete isciler[i]; }
+        double ms = gecenMs(t0, std::chrono::steady_clock::now());
+        delete cikis;
+        if (isci == 1) tekIsciMs = ms;
+        printf("%3d isci : %10.2f ms  %10.0f istek/sn  olcek %.2fx\n", isci, ms, ms > 0 ? istekSayisi / (ms / 1000.0) : 0.0, ms > 0 ? tekIsciMs / ms : 0.0);
+        if (isci == enCok) break;
     }
-    printf("Durak: %s (%d)\n", durakNameArr[durakID], durakID);
-    printf("  Bulundugu Hatlar:");
-    BagliNode<int>* ln = node->hatList.head(); int hatSayCount = 0;
-    while (ln) { printf(" %d", ln->val); hatSayCount++; ln = ln->next; }
-    if (hatSayCount == 0) { printf(" (hat bulunamadi)"); }
-    printf("\n");
+    ::close(bosCikis);
+    for (int i = 0; i < istekler.size(); ++i) std::free(istekler[i]);
 }
 
-//  Tüm Hatları Listele 
-void tumHatlariListele() {
-    printf("\n--- Tüm Hatlar ---\n");
-    for (int i = 0; i < hatSayisi; ++i) {
-        printf("Hat %d  (%s)\n", hatNoArr[i], hatNameArr[i]);
+// Rastgele bas/bit ciftlerinde anlik dijkstra ile on hesaplanmis tablo sorgusunu karsilastirir
+void benchTablo(int tekrar) {
+    int V = durakSayisi;
+    if (!mesafeTablosu.hazir()) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        mesafeTablosu.hesapla(globalGraph, (int) std::thread::hardware_concurrency());
+        printf("Tablo on hesaplama: %.2f ms\n", gecenMs(t0, std::chrono::steady_clock::now()));
+    }
+    int sorgu = tekrar * 100;
+    Rastgele rng(7);
+    int* ciftler = (int*) std::malloc(sizeof(int) * 2 * sorgu);
+    for (int i = 0; i < 2 * sorgu; ++i) ciftler[i] = rng.aralik(0, V - 1);
+    int* dist = (int*) std::malloc(sizeof(int) * V);
+    int* parent = (int*) std::malloc(sizeof(int) * V);
+    int* path = (int*) std::malloc(sizeof(int) * V);
+    long long uzunlukDijkstra = 0, uzunlukTablo = 0;
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < sorgu; ++i) {
+        globalGraph.dijkstra(ciftler[2*i], dist, parent);
+        int n = parentRotasi(dist, parent, ciftler[2*i+1], path);
+        if (n) uzunlukDijkstra += dist[ciftler[2*i+1]];
     }
-    printf(">>> Toplam hat sayisi: %d\n", hatSayisi);
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < sorgu; ++i) {
+        int n = mesafeTablosu.rota(ciftler[2*i], ciftler[2*i+1], path);
+        if (n) uzunlukTablo += mesafeTablosu.mesafe(ciftler[2*i], ciftler[2*i+1]);
+    }
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+
+    double msD = gecenMs(t0, t1), msT = gecenMs(t1, t2);
+    printf("\n--- Tablo ile Sorgu (V=%d, %d sorgu) ---\n", V, sorgu);
+    printf("Anlik dijkstra : %10.2f ms  %12.0f sorgu/sn\n", msD, msD > 0 ? sorgu / (msD / 1000.0) : 0.0);
+    printf("Tablo          : %10.2f ms  %12.0f sorgu/sn\n", msT, msT > 0 ? sorgu / (msT / 1000.0) : 0.0);
+    if (msT > 0) printf("Hizlanma       : %.1fx\n", msD / msT);
+    if (uzunlukDijkstra != uzunlukTablo) printf("UYARI: iki yontem farkli mesafe verdi!\n");
+    std::free(ciftler); std::free(dist); std::free(parent); std::free(path);
 }
 
-// Bir Hattın Duraklarını Göster 
-void hatDuraklariGoster(int hatNo) {
-    if (hatNo <= 0) { printf("Gecersiz hat numarasi.\n"); return; }
-    int idx = -1;
-    for (int i = 0; i < hatSayisi; ++i) if (hatNoArr[i] == hatNo) { idx = i; break; }
-    if (idx < 0) { printf("HATA: Hat %d bulunamadi.\n", hatNo); return; }
+// Rastgele bas/bit ciftlerinde tam dijkstra, erken duran tek hedefli ve cift yonlu aramayi karsilastirir
+void benchNoktaNokta(int tekrar) {
+    int V = durakSayisi;
+    int sorgu = tekrar * 50;
+    Rastgele rng(11);
+    int* ciftler = (int*) std::malloc(sizeof(int) * 2 * sorgu);
+    for (int i = 0; i < 2 * sorgu; ++i) ciftler[i] = rng.aralik(0, V - 1);
+    AramaTamponu t;
+    long long mesafeTam = 0, mesafeHedef = 0, mesafeCift = 0;
+    long long yerlesenHedef = 0, yerlesenCift = 0;
 
-    VecArr<char*>& isimList = hatDurakAdlari[idx];
-    if (isimList.size() == 0) {
-        printf("HatNo %d (%s) icin durak yok.\n", hatNoArr[idx], hatNameArr[idx]);
-        return;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < sorgu; ++i) {
+        globalGraph.dijkstra(ciftler[2*i], t.dist, t.parent);
+        if (t.dist[ciftler[2*i+1]] != INT_MAX) mesafeTam += t.dist[ciftler[2*i+1]];
     }
-    printf("\nHatNo %d (%s) Duraklar (%d):\n", hatNoArr[idx], hatNameArr[idx], isimList.size());
-    for (int i = 0; i < isimList.size(); ++i) {
-        if (isimList[i] == nullptr) { printf("  [GECERSİZ durak ismi]\n"); continue; }
-        const char* name = isimList[i];
-        int durakID = findDurakIDbyName(name);
-        if (durakID < 1 || durakID > MAX_DURAK) { printf("  %s [Gecersiz Durak]\n", name); }
-        else { printf("  %s (%d)\n", name, durakID); }
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < sorgu; ++i) {
+        int yerlesen = 0;
+        int d = globalGraph.dijkstraHedef(ciftler[2*i], ciftler[2*i+1], t.dist, t.parent, yerlesen);
+        if (d != INT_MAX) mesafeHedef += d;
+        yerlesenHedef += yerlesen;
+    }
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+    for (int i = 0; i < sorgu; ++i) {
+        int yerlesen = 0;
+        int n = globalGraph.dijkstraCiftYonlu(ciftler[2*i], ciftler[2*i+1], t.dist, t.parent, t.distB, t.parentB, t.path, yerlesen);
+        for (int k = 0; k + 1 < n; ++k) {
+            int e = globalGraph.findEdge(t.path[k], t.path[k+1]);
+            int w = INT_MAX;
+            for (int f = e; f != -1 && f < globalGraph.edgeEnd(t.path[k]); ++f)   // paralel kenarlardan en hafifi
+                if (globalGraph.edgeDest(f) == t.path[k+1] && globalGraph.edgeWeight(f) < w) w = globalGraph.edgeWeight(f);
+            mesafeCift += w;
+        }
+        yerlesenCift += yerlesen;
     }
-    printf(">>> HatNo %d icin toplam %d durak bulundu.\n", hatNo, isimList.size());
+    std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
+
+    double ms[3] = { gecenMs(t0, t1), gecenMs(t1, t2), gecenMs(t2, t3) };
+    double yerlesen[3] = { (double) V, (double) yerlesenHedef / sorgu, (double) yerlesenCift / sorgu };
+    const char* ad[3] = { "Tam dijkstra  ", "Tek hedefli   ", "Cift yonlu    " };
+    printf("\n--- Noktadan Noktaya Arama (V=%d, %d sorgu) ---\n", V, sorgu);
+    for (int i = 0; i < 3; ++i)
+        printf("%s: %10.2f ms  %10.0f sorgu/sn  ort. yerlesen %10.1f\n", ad[i], ms[i], ms[i] > 0 ? sorgu / (ms[i] / 1000.0) : 0.0, yerlesen[i]);
+    if (mesafeTam != mesafeHedef || mesafeTam != mesafeCift) printf("UYARI: yontemler farkli mesafe verdi! (%lld %lld %lld)\n", mesafeTam, mesafeHedef, mesafeCift);
+    std::free(ciftler);
 }
 
-// === Yolcu Planla Fonksiyonu ===
-void yolcuPlanla(const char* yolcuFile, int arananYolcuID) {
-    FILE* fp = std::fopen(yolcuFile, "r");
-    if (!fp) { std::perror("yolcu_listesi.txt acilamadi"); return; }
-    char line[16000];
-    std::fgets(line, sizeof(line), fp);
+// Dijkstra benzeri yuk: n dugum eklenir, her cikarmada yigindaki rastgele iki dugumun anahtari
+// kucultulur. Anahtarlarin alt 16 biti dugum numarasi oldugu icin esitlik olmaz ve her yigin
+// ayni islem dizisini gorur; cikan anahtarlarin toplami doner (n <= 65536)
+template <class H>
+static long long heapYuku(H& h, int n, unsigned long long tohum) {
+    Rastgele rng(tohum);
+    int* anahtar = (int*) std::malloc(sizeof(int) * n);
+    int* yiginda = (int*) std::malloc(sizeof(int) * n);   // yigindaki dugumler (sirasiz)
+    int* yer = (int*) std::malloc(sizeof(int) * n);
+    for (int v = 0; v < n; ++v) {
+        anahtar[v] = (rng.aralik(16000, 30000) << 16) | v;
+        h.insert(v, anahtar[v]);
+        yiginda[v] = v; yer[v] = v;
+    }
+    int kalan = n, sonMin = 0;
+    long long toplam = 0;
+    while (!h.isEmpty()) {
+        HeapN hn = h.extractMin();
+        toplam += hn.dist; sonMin = hn.dist;
+        int y = yer[hn.vertex];
+        yiginda[y] = yiginda[--kalan]; yer[yiginda[y]] = y;
+        for (int k = 0; k < 2 && kalan > 0; ++k) {
+            int v = yiginda[rng.aralik(0, kalan - 1)];
+            int ust = (sonMin >> 16) + ((anahtar[v] >> 16) - (sonMin >> 16)) / 2;
+            int yeni = (ust << 16) | v;
+            if (yeni < anahtar[v]) { anahtar[v] = yeni; h.decreaseKey(v, yeni); }
+        }
+    }
+    std::free(anahtar); std::free(yiginda); std::free(yer);
+    return toplam;
+}
 
-    bool bulundu = false;
-    while (std::fgets(line, sizeof(line), fp)) {
-        char* token = std::strtok(line, ",");
-        if (!token) continue;
-        int yolcuID = std::atoi(token);
-        if (yolcuID != arananYolcuID) continue;
-        bulundu = true;
+// Eski MinHeap ile indeksli d-li yiginlari ayni islem dizisinde karsilastirir
+void benchHeap(int tekrar) {
+    int n = 1 << 16;
+    double ms[4] = { 0, 0, 0, 0 };
+    long long kontrol[4] = { 0, 0, 0, 0 };
+    for (int r = 0; r < tekrar; ++r) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        { MinHeap h(n); kontrol[0] += heapYuku(h, n, r + 1); }
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        { IndeksliHeap<2> h(n); kontrol[1] += heapYuku(h, n, r + 1); }
+        std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+        { IndeksliHeap<4> h(n); kontrol[2] += heapYuku(h, n, r + 1); }
+        std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
+        { IndeksliHeap<8> h(n); kontrol[3] += heapYuku(h, n, r + 1); }
+        std::chrono::steady_clock::time_point t4 = std::chrono::steady_clock::now();
+        ms[0] += gecenMs(t0, t1); ms[1] += gecenMs(t1, t2); ms[2] += gecenMs(t2, t3); ms[3] += gecenMs(t3, t4);
+    }
+    const char* ad[4] = { "MinHeap (eski)   ", "IndeksliHeap<2>  ", "IndeksliHeap<4>  ", "IndeksliHeap<8>  " };
+    double islem = (double) tekrar * n * 4;   // ekleme + cikarma + ~2 kucultme
+    printf("\n--- Yigin Karsilastirmasi (%d dugum x %d tekrar) ---\n", n, tekrar);
+    for (int i = 0; i < 4; ++i)
+        printf("%s: %10.2f ms  %8.1f ns/islem\n", ad[i], ms[i], ms[i] * 1e6 / islem);
+    for (int i = 1; i < 4; ++i) if (kontrol[i] != kontrol[0]) printf("UYARI: %s farkli sonuc verdi!\n", ad[i]);
+}
+
+// VecArr eleman erisimi (at / operator[] / yineleyici) ve ic ice dizilerde kopya / tasima ile buyume
+void benchVecArr(int tekrar) {
+    int n = 1 << 14;                 // L2'ye sigar, olcum bellek gecikmesine degil erisim koduna bakar
+    tekrar *= 64;
+    VecArr<int> v, sira;
+    v.reserve(n); sira.reserve(n);
+    Rastgele rng(3);
+    for (int i = 0; i < n; ++i) { v.pushLast(i & 1023); sira.pushLast(rng.aralik(0, n - 1)); }
+    long long t[3] = { 0, 0, 0 };
+
+    // yigin elemesi gibi veriye bagli indekslerle erisim: kontrol donguden disari alinamaz
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < tekrar; ++r) { long long a = 0; for (int i = 0; i < n; ++i) a += v.at(sira.at(i)); t[0] += a; }
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < tekrar; ++r) { long long a = 0; for (int i = 0; i < n; ++i) a += v[sira[i]]; t[1] += a; }
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+    for (int r = 0; r < tekrar; ++r) { long long a = 0; for (const int* it = sira.begin(); it != sira.end(); ++it) a += v[*it]; t[2] += a; }
+    std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
 
-        token = std::strtok(nullptr, ",");
-        if (!token) continue;
-        char adSoyad[256];
-        while (*token == ' ' || *token == '\t' || *token == '\n' || *token == '\r') ++token;
-        int len = std::strlen(token);
-        while (len > 0 && (token[len - 1] == ' ' || token[len - 1] == '\t' || token[len - 1] == '\n' || token[len - 1] == '\r')) token[--len] = '\0';
-        std::strncpy(adSoyad, token, 256); adSoyad[255] = '\0';
+    // ic ice dizi: her biri 16 elemanli 'ic' dizilerin dis diziye eklenmesi
+    int dis = 1 << 16;
+    std::chrono::steady_clock::time_point t4 = std::chrono::steady_clock::now();
+    for (int r = 0; r < tekrar; ++r) {
+        VecArr< VecArr<int> > vv;
+        for (int i = 0; i < dis; ++i) { VecArr<int> ic; for (int k = 0; k < 16; ++k) ic.pushLast(k); vv.pushLast(ic); }
+    }
+    std::chrono::steady_clock::time_point t5 = std::chrono::steady_clock::now();
+    for (int r = 0; r < tekrar; ++r) {
+        VecArr< VecArr<int> > vv;
+        for (int i = 0; i < dis; ++i) { VecArr<int> ic; for (int k = 0; k < 16; ++k) ic.pushLast(k); vv.pushLast(std::move(ic)); }
+    }
+    std::chrono::steady_clock::time_point t6 = std::chrono::steady_clock::now();
+
+    double erisim = (double) n * tekrar;
+#ifdef NDEBUG
+    const char* derleme = "NDEBUG: operator[] kontrolsuz";
+#else
+    const char* derleme = "hata ayiklama: operator[] kontrollu";
+#endif
+    printf("\n--- VecArr Erisim (%d eleman x %d tekrar, %s) ---\n", n, tekrar, derleme);
+    printf("at()        : %8.2f ms  %6.2f ns/eleman\n", gecenMs(t0, t1), gecenMs(t0, t1) * 1e6 / erisim);
+    printf("operator[]  : %8.2f ms  %6.2f ns/eleman\n", gecenMs(t1, t2), gecenMs(t1, t2) * 1e6 / erisim);
+    printf("yineleyici  : %8.2f ms  %6.2f ns/eleman\n", gecenMs(t2, t3), gecenMs(t2, t3) * 1e6 / erisim);
+    printf("Ic ice buyume (%d x 16): kopya %.2f ms, tasima %.2f ms\n", dis, gecenMs(t4, t5), gecenMs(t5, t6));
+    if (t[0] != t[1] || t[1] != t[2]) printf("UYARI: erisim yollari farkli toplam verdi!\n");
+}
 
-        token = std::strtok(nullptr, ","); if (!token) continue;
-        int basID = std::atoi(token);
+// Yukleme sirasindaki dugum ayirmalari, tepe bellek (RSS) ve toplu birakma suresi
+void benchYukleme(double yuklemeMs) {
+    const Arena& ga = globalGraph.arenaBilgisi();
+    long long ayirma = ga.ayirmaSayisi + tekilAyirmaSayisi;
+    long long mallocSayisi = arenaAcik ? ga.blokSayisi : tekilAyirmaSayisi;
+    rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    globalGraph.init(0, arenaAcik);
+    double birakmaMs = gecenMs(t0, std::chrono::steady_clock::now());
 
-        token = std::strtok(nullptr, ","); if (!token) continue;
-        int bitID = std::atoi(token);
+    printf("\n--- Yukleme Bellegi (%s) ---\n", arenaAcik ? "arena" : "tek tek new/delete");
+    printf("Yukleme suresi      : %.2f ms\n", yuklemeMs);
+    printf("Dugum/kenar ayirma  : %lld\n", ayirma);
+    printf("malloc cagrisi      : %lld\n", mallocSayisi);
+    if (arenaAcik) printf("Arena bloklari      : %.2f MB\n", ga.toplamBayt / (1024.0 * 1024.0));
+    printf("Tepe RSS            : %.2f MB\n", ru.ru_maxrss / 1024.0);
+    printf("Birakma suresi      : %.2f ms\n", birakmaMs);
+}
 
-        const char* bas_adi = (basID >= 1 && basID <= MAX_DURAK) ? durakNameArr[basID] : "Bilinmiyor";
-        const char* bit_adi = (bitID >= 1 && bitID <= MAX_DURAK) ? durakNameArr[bitID] : "Bilinmiyor";
+// Durak -> hat indeksi: eski BST ile duz ofset tablosu, sirali ve karisik ekleme sirasinda.
+// Her durak 3 hatta bulunur; arama tum duraklar uzerinden karisik sirada yapilir
+void benchIndeks(int tekrar) {
+    int n = durakSayisi > 20000 ? durakSayisi : 20000;
+    const int hatBasina = 3;
+    VecArr<int> sirali, karisik;
+    for (int d = 1; d <= n; ++d) for (int k = 0; k < hatBasina; ++k) sirali.pushLast(d);
+    karisik = sirali;
+    Rastgele rng(7);
+    for (int i = karisik.size() - 1; i > 0; --i) { int j = rng.aralik(0, i); int t = karisik[i]; karisik[i] = karisik[j]; karisik[j] = t; }
+    VecArr<int> sorgu;
+    for (int d = 1; d <= n; ++d) sorgu.pushLast(d);
+    for (int i = n - 1; i > 0; --i) { int j = rng.aralik(0, i); int t = sorgu[i]; sorgu[i] = sorgu[j]; sorgu[j] = t; }
 
-        printf("\nYolcu: %s\nBaslangic: %s (Id: %d)\nBitis: %s (Id: %d)\n", adSoyad, bas_adi, basID, bit_adi, bitID);
+    printf("\n--- Durak-Hat Indeksi (%d durak, %d ekleme, %d tekrar) ---\n", n, sirali.size(), tekrar);
+    printf("%-8s %-10s %12s %14s %8s\n", "sira", "yapi", "ekleme ms", "ns/arama", "derinlik");
+    for (int s = 0; s < 2; ++s) {
+        VecArr<int>& giris = s == 0 ? sirali : karisik;
+        const char* ad = s == 0 ? "sirali" : "karisik";
+        double bstEkle = 0, bstAra = 0, idxEkle = 0, idxAra = 0;
+        long long kontrolBst = 0, kontrolIdx = 0;
+        int derinlik = 0;
+        for (int r = 0; r < tekrar; ++r) {
+            DurakHatBST bst;
+            std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < giris.size(); ++i) bst.insert(giris[i], i);
+            std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+            for (int i = 0; i < n; ++i) { BSTNode* node = bst.search(sorgu[i]); if (node) kontrolBst += node->hatList.head()->val; }
+            std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+            bstEkle += gecenMs(t0, t1); bstAra += gecenMs(t1, t2);
+            derinlik = bst.derinlik();
 
-        if (basID < 1 || basID > MAX_DURAK || bitID < 1 || bitID > MAX_DURAK) {
-            printf("  Gecersiz durak ID: basID=%d, bitID=%d\n", basID, bitID); break;
+            DurakHatIndeksi idx;
+            t0 = std::chrono::steady_clock::now();
+            idx.baslat(n);
+            for (int i = 0; i < giris.size(); ++i) idx.ekle(giris[i], i);
+            idx.sikistir();
+            t1 = std::chrono::steady_clock::now();
+            for (int i = 0; i < n; ++i) if (idx.hatSayisi(sorgu[i]) > 0) kontrolIdx += idx.hatlar(sorgu[i])[0];
+            t2 = std::chrono::steady_clock::now();
+            idxEkle += gecenMs(t0, t1); idxAra += gecenMs(t1, t2);
         }
+        printf("%-8s %-10s %12.2f %14.1f %8d\n", ad, "BST", bstEkle / tekrar, bstAra * 1e6 / ((double) n * tekrar), derinlik);
+        printf("%-8s %-10s %12.2f %14.1f %8d\n", ad, "ofset", idxEkle / tekrar, idxAra * 1e6 / ((double) n * tekrar), 1);
+        if (kontrolBst != kontrolIdx) printf("UYARI: iki yapi farkli sonuc verdi!\n");
+    }
+}
 
-        int* dist = (int*) std::malloc(sizeof(int) * MAX_DURAK);
-        int* parent = (int*) std::malloc(sizeof(int) * MAX_DURAK);
+// Girdi dosyalarini eski getline + strtok + kirpma dongusuyle ve ortak CsvOkuyucu ile
+// alanlarina ayirir (bos olmayan alan sayilir), MB/s olarak karsilastirir
+void benchCsv(int tekrar) {
+    const char* dosyalar[] = { "durak_listesi.txt", "hatlar.txt", "durak_mesafeleri.txt", "yolcu_listesi.txt" };
+    printf("\n--- CSV Ayristirma (%d tekrar) ---\n", tekrar);
+    printf("%-22s %10s %14s %14s %8s\n", "dosya", "MB", "getline MB/s", "CsvOkuyucu MB/s", "hiz");
+    for (int d = 0; d < 4; ++d) {
+        long long alanEski = 0, alanYeni = 0, bayt = 0;
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        for (int r = 0; r < tekrar; ++r) {
+            FILE* f = std::fopen(dosyalar[d], "r");
+            if (!f) break;
+            char* line = nullptr; size_t lineCap = 0;
+            while (getline(&line, &lineCap, f) != -1) {
+                for (char* token = std::strtok(line, ","); token; token = std::strtok(nullptr, ",")) {
+                    while (*token == ' ' || *token == '\t' || *token == '\n' || *token == '\r') ++token;
+                    int len = std::strlen(token);
+                    while (len > 0 && (token[len - 1] == ' ' || token[len - 1] == '\t' || token[len - 1] == '\n' || token[len - 1] == '\r')) token[--len] = '\0';
+                    if (len > 0) alanEski++;
+                }
+            }
+            std::free(line);
+            std::fclose(f);
+        }
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        for (int r = 0; r < tekrar; ++r) {
+            CsvOkuyucu csv;
+            if (!csv.ac(dosyalar[d])) break;
+            bayt = csv.bayt();
+            Alan a;
+            while (csv.satir())
+                while (csv.alan(a)) if (a.n > 0) alanYeni++;
+        }
+        std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+        if (bayt == 0) { printf("%-22s (okunamadi veya bos)\n", dosyalar[d]); continue; }
+        double mb = bayt * (double) tekrar / 1e6;
+        double eski = mb / (gecenMs(t0, t1) / 1e3), yeni = mb / (gecenMs(t1, t2) / 1e3);
+        printf("%-22s %10.2f %14.1f %14.1f %7.1fx\n", dosyalar[d], bayt / 1e6, eski, yeni, yeni / eski);
+        if (alanEski != alanYeni) printf("UYARI: alan sayilari farkli (%lld / %lld)\n", alanEski, alanYeni);
+    }
+}
 
-        globalGraph.dijkstra(basID-1, dist, parent);
+// Yogun mesafe matrisini onceki alan() + esit("-") + tamsayi() dongusuyle ve vektorel satir
+// ayristiricisiyla okur (kenarlar sayilip ozetlenir), MB/s olarak karsilastirir
+void benchMatris(int tekrar) {
+    CsvOkuyucu csv;
+    if (!csv.ac("durak_mesafeleri.txt")) { std::perror("durak_mesafeleri.txt"); return; }
+    if (mesafeBicimiBelirle(csv)) { printf("durak_mesafeleri.txt kenar listesi, matris olcumu atlandi\n"); return; }
+    const char* bas = csv.kalanBas();
+    long long bayt = csv.sonu() - bas;
+    long long kenarEski = 0, kenarYeni = 0;
+    unsigned long long ozetEski = 0, ozetYeni = 0;
+    Alan a;
 
-        if (dist[bitID-1] == INT_MAX) {
-            printf("  %d'den %d'ye yol bulunamadi.\n", basID, bitID);
-            free(dist); free(parent); break;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < tekrar; ++r) {
+        CsvOkuyucu parca;
+        parca.baglan(bas, bayt);
+        for (int row = 0; parca.satir(); row++) {
+            if (parca.bosSatir()) continue;
+            for (int col = 0; parca.alan(a); col++)
+                if (a.n && !a.esit("-")) { kenarEski++; ozetEski = ozetEski * 31 + (unsigned) (row * 7919 + col) + (unsigned) a.tamsayi(); }
         }
+    }
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < tekrar; ++r) {
+        CsvOkuyucu parca;
+        parca.baglan(bas, bayt);
+        mesafeSatirlariOku(parca, false, [&kenarYeni, &ozetYeni](int u, int v, int w) {
+            kenarYeni++; ozetYeni = ozetYeni * 31 + (unsigned) (u * 7919 + v) + (unsigned) w;
+        });
+    }
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
 
-        int path[MAX_DURAK], pathLen = 0;
-        int crawl = bitID-1; path[pathLen++] = crawl;
-        while (parent[crawl] != -1) { crawl = parent[crawl]; path[pathLen++] = crawl; }
-        for (int i = 0; i < pathLen/2; i++) { int temp = path[i]; path[i] = path[pathLen-1-i]; path[pathLen-1-i] = temp; }
+    double mb = bayt * (double) tekrar / 1e6;
+    double eski = mb / (gecenMs(t0, t1) / 1e3), yeni = mb / (gecenMs(t1, t2) / 1e3);
+    printf("\n--- Mesafe Matrisi Ayristirma (%.2f MB, %lld kenar, %d tekrar, %s) ---\n", bayt / 1e6, kenarYeni / tekrar, tekrar, MATRIS_SIMD);
+    printf("alan() dongusu : %10.1f MB/s\n", eski);
+    printf("vektorel       : %10.1f MB/s  (%.1fx)\n", yeni, yeni / eski);
+    if (kenarEski != kenarYeni || ozetEski != ozetYeni) printf("UYARI: iki ayristirici farkli kenar verdi!\n");
+}
 
-        printf("\nRota :\n");
-        int prevLine = -1;
-        for (int i = 0; i < pathLen-1; i++) {
-            int u = path[i];
-            int v = path[i+1];
-            BagliNode<Edge*>* en = globalGraph.getAdj(u).head();
-            int foundLine = -1;
-            while (en) {
-                if (en->val->dest == v) {
-                    BagliNode<int>* hn = en->val->lineList.head();
-                    if (hn) {
-                        if (prevLine != -1) {
-                            BagliNode<int>* hn2 = en->val->lineList.head();
-                            while (hn2) {
-                                if (hn2->val == prevLine) { foundLine = prevLine; break; }
-                                hn2 = hn2->next;
-                            }
-                        }
-                        if (foundLine == -1) foundLine = hn->val;
-                    }
-                    break;
+// Yuklemeyi 1, 2, 4, ... isciyle tekrarlar. Her olcum ayri bir alt surecte (fork) yapilir:
+// alt surec global ag yapilarini bosaltip grafOlustur'u bastan calistirir, sureyi ve CSR
+// ozetini boruya yazip cikar (eski hat adlari serbest birakilmaz, surec zaten biter)
+void benchParalelYukleme(int tekrar) {
+    int cekirdek = (int) std::thread::hardware_concurrency();
+    if (cekirdek < 1) cekirdek = 1;
+    int enCok = cekirdek > 4 ? cekirdek : 4;
+    struct Sonuc { double ms; unsigned ozet; int E; };
+    printf("\n--- Paralel Yukleme (%d cekirdek, en iyi %d deneme) ---\n", cekirdek, tekrar);
+    printf("%-8s %12s %10s %12s\n", "isci", "en iyi ms", "hizlanma", "CSR ozeti");
+    double tekIsciMs = 0; unsigned ilkOzet = 0;
+    for (int isci = 1; isci <= enCok; isci *= 2) {
+        Sonuc enIyi; enIyi.ms = -1; enIyi.ozet = 0; enIyi.E = 0;
+        for (int r = 0; r < tekrar; ++r) {
+            int boru[2];
+            if (::pipe(boru) != 0) { std::perror("pipe"); return; }
+            std::fflush(stdout);
+            pid_t pid = ::fork();
+            if (pid == 0) {
+                ::close(boru[0]);
+                durakIsimleri.temizle();
+                hatNoArr.clear(); hatNameArr.clear(); hatDuraklari.clear(); hatDurakAdlari.clear();
+                yuklemeIscisi = isci;
+                std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+                grafOlustur("durak_listesi.txt", "hatlar.txt", "durak_mesafeleri.txt", globalGraph);
+                Sonuc s; s.ms = gecenMs(t0, std::chrono::steady_clock::now());
+                s.ozet = 2166136261u; s.E = globalGraph.edgeCount();
+                for (int e = 0; e < s.E; ++e) {
+                    int kenar[2] = { globalGraph.edgeDest(e), globalGraph.edgeWeight(e) };
+                    s.ozet = fnvOzet(kenar, sizeof(kenar), s.ozet);
+                    s.ozet = fnvOzet(globalGraph.edgeLinesBegin(e), (globalGraph.edgeLinesEnd(e) - globalGraph.edgeLinesBegin(e)) * sizeof(int), s.ozet);
                 }
-                en = en->next;
+                ssize_t yazilan = ::write(boru[1], &s, sizeof(s));
+                ::_exit(yazilan == (ssize_t) sizeof(s) ? 0 : 1);
             }
-            if (foundLine == -1 && prevLine != -1) foundLine = prevLine;
-            if (foundLine == -1) {
-                for (int j = i+1; j < pathLen-1; j++) {
-                    int uu = path[j]; int vv = path[j+1];
-                    BagliNode<Edge*>* enn = globalGraph.getAdj(uu).head();
-                    while (enn) {
-                        if (enn->val->dest == vv) {
-                            BagliNode<int>* hnn = enn->val->lineList.head();
-                            if (hnn) { foundLine = hnn->val; break; }
-                        }
-                        enn = enn->next;
-                    }
-                    if (foundLine != -1) break;
+            ::close(boru[1]);
+            Sonuc s;
+            bool ok = pid > 0 && ::read(boru[0], &s, sizeof(s)) == (ssize_t) sizeof(s);
+            ::close(boru[0]);
+            if (pid > 0) ::waitpid(pid, nullptr, 0);
+            if (!ok) { printf("alt surec basarisiz (isci=%d)\n", isci); return; }
+            if (enIyi.ms < 0 || s.ms < enIyi.ms) enIyi = s;
+        }
+        if (isci == 1) { tekIsciMs = enIyi.ms; ilkOzet = enIyi.ozet; }
+        printf("%-8d %12.2f %9.2fx %12x\n", isci, enIyi.ms, tekIsciMs / enIyi.ms, enIyi.ozet);
+        if (enIyi.ozet != ilkOzet) printf("UYARI: graf tek iscili yuklemeden farkli!\n");
+    }
+}
+
+// Yolcu arama: dosya taramasi ile indeksli depo; ayrica dosyanin gecici kopyasina %10 satir
+// eklenip artimli yenileme tam yeniden kurulumla karsilastirilir
+void benchYolcu(int tekrar) {
+    YolcuDeposu depo;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    if (!depo.yenile("yolcu_listesi.txt")) { std::perror("yolcu_listesi.txt"); return; }
+    double kurMs = gecenMs(t0, std::chrono::steady_clock::now());
+    int n = depo.yolcuSayisi();
+    if (n == 0) { printf("Yolcu yok\n"); return; }
+    CsvOkuyucu csv;
+    csv.ac("yolcu_listesi.txt");
+
+    Rastgele rng(11);
+    char ad[256]; int bas, bit;
+    long long kontrolLineer = 0, kontrolIndeks = 0;
+    VecArr<int> idler;
+    for (int i = 0; i < tekrar; ++i) idler.pushLast(rng.aralik(1, n));
+    t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < tekrar; ++i) if (yolcuBulLineer(csv, idler[i], ad, bas, bit)) kontrolLineer += bas + bit;
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    int indeksTur = 100000;
+    for (int i = 0; i < indeksTur; ++i) if (depo.bul(idler[i % tekrar], ad, bas, bit) && i < tekrar) kontrolIndeks += bas + bit;
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+
+    printf("\n--- Yolcu Arama (%d yolcu, %.2f MB) ---\n", n, csv.bayt() / 1e6);
+    printf("Indeks kurulumu     : %10.2f ms\n", kurMs);
+    printf("Dogrusal tarama     : %10.1f us/arama\n", gecenMs(t0, t1) * 1e3 / tekrar);
+    printf("Indeksli depo       : %10.3f us/arama\n", gecenMs(t1, t2) * 1e3 / indeksTur);
+    if (kontrolLineer != kontrolIndeks) printf("UYARI: iki arama farkli sonuc verdi!\n");
+
+    // artimli yenileme: gecici kopyaya ekle
+    char gecici[] = "/tmp/ulasim_yolcuXXXXXX";
+    int fd = ::mkstemp(gecici);
+    if (fd < 0) { std::perror("mkstemp"); return; }
+    FILE* f = ::fdopen(fd, "w");
+    std::fwrite(csv.veri(), 1, csv.bayt(), f);
+    if (csv.bayt() > 0 && csv.veri()[csv.bayt() - 1] != '\n') std::fputc('\n', f);
+    std::fclose(f);
+    YolcuDeposu artimli;
+    artimli.yenile(gecici);
+    int ek = n / 10 > 0 ? n / 10 : 1;
+    f = std::fopen(gecici, "a");
+    for (int i = 1; i <= ek; ++i) std::fprintf(f, "%d,Ek Yolcu %d,%d,%d\n", n + i, i, rng.aralik(1, durakSayisi), rng.aralik(1, durakSayisi));
+    std::fclose(f);
+    t0 = std::chrono::steady_clock::now();
+    artimli.yenile(gecici);
+    t1 = std::chrono::steady_clock::now();
+    long long artimliBayt = artimli.sonTaramaBayt;
+    YolcuDeposu bastan;
+    bastan.yenile(gecici);
+    t2 = std::chrono::steady_clock::now();
+    bool tamam = artimli.yolcuSayisi() == bastan.yolcuSayisi() && artimli.bul(n + ek, ad, bas, bit);
+    ::unlink(gecici);
+    printf("+%d satir sonrasi yenileme:\n", ek);
+    printf("  artimli           : %10.2f ms  (%.2f MB tarandi)\n", gecenMs(t0, t1), artimliBayt / 1e6);
+    printf("  bastan            : %10.2f ms  (%.2f MB tarandi)\n", gecenMs(t1, t2), bastan.sonTaramaBayt / 1e6);
+    if (!tamam) printf("UYARI: artimli indeks eksik!\n");
+}
+
+// Yardimci: rotanin toplam mesafesi (paralel kenarlardan en hafifi), yol yoksa -1
+static long long rotaMaliyeti(const int* path, int n) {
+    if (n == 0) return -1;
+    long long toplam = 0;
+    for (int k = 0; k + 1 < n; ++k) {
+        int w = INT_MAX;
+        for (int e = globalGraph.edgeBegin(path[k]); e < globalGraph.edgeEnd(path[k]); ++e)
+            if (globalGraph.edgeDest(e) == path[k + 1] && globalGraph.edgeWeight(e) < w) w = globalGraph.edgeWeight(e);
+        toplam += w;
+    }
+    return toplam;
+}
+
+// Baslangiclari kucuk bir "sicak" kumeden (duraklarin %5'i) secilen sorgular: onbelleksiz cift
+// yonlu arama ile farkli bellek sinirlarinda LRU onbellek. Isabet orani, sure ve tahliye yazilir
+void benchOnbellek(int tekrar) {
+    int V = durakSayisi;
+    int sorgu = tekrar * 500;
+    int sicak = V / 20 > 0 ? V / 20 : 1;
+    Rastgele rng(5);
+    VecArr<int> ciftler;
+    for (int i = 0; i < sorgu; ++i) {
+        // %80 sicak baslangic, %20 rastgele
+        ciftler.pushLast(rng.aralik(0, 9) < 8 ? rng.aralik(0, sicak - 1) * 20 % V : rng.aralik(0, V - 1));
+        ciftler.pushLast(rng.aralik(0, V - 1));
+    }
+    AramaTamponu t;
+    bool aktarmali = aktarmaMotoru.hazir();
+    int agacBoyu = aktarmali ? aktarmaMotoru.durumSayisi() + 1 : V;
+    double agacMB = 2.0 * agacBoyu * sizeof(int) / (1024.0 * 1024.0);
+    printf("\n--- Yol Agaci Onbellegi (%d sorgu, %d sicak baslangic, agac %.3f MB%s) ---\n",
+           sorgu, sicak, agacMB, aktarmali ? ", aktarma duyarli" : "");
+    printf("%-14s %10s %12s %9s %9s\n", "onbellek", "ms", "us/sorgu", "isabet", "tahliye");
+
+    long long kontrol = 0;
+    yolOnbellegi.kapat();
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < sorgu; ++i) { int n = rotaBul(ciftler[2*i], ciftler[2*i+1], t); if (!aktarmali) kontrol += rotaMaliyeti(t.path, n); }
+    double yokMs = gecenMs(t0, std::chrono::steady_clock::now());
+    printf("%-14s %10.2f %12.1f %9s %9s\n", "kapali", yokMs, yokMs * 1e3 / sorgu, "-", "-");
+
+    int agaclar[] = { sicak / 4, sicak, sicak * 4 };
+    for (int a = 0; a < 3; ++a) {
+        int kayit = agaclar[a] > 0 ? agaclar[a] : 1;
+        yolOnbellegi.kur(V, agacBoyu, (long long) kayit * 2 * agacBoyu * sizeof(int));
+        long long kontrolOnbellek = 0;
+        t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < sorgu; ++i) { int n = rotaBul(ciftler[2*i], ciftler[2*i+1], t); if (!aktarmali) kontrolOnbellek += rotaMaliyeti(t.path, n); }
+        double ms = gecenMs(t0, std::chrono::steady_clock::now());
+        char ad[32];
+        std::snprintf(ad, sizeof(ad), "%d agac", kayit);
+        printf("%-14s %10.2f %12.1f %8.1f%% %9lld\n", ad, ms, ms * 1e3 / sorgu,
+               100.0 * yolOnbellegi.isabet / (yolOnbellegi.isabet + yolOnbellegi.iska), yolOnbellegi.tahliye);
+        if (!aktarmali && kontrolOnbellek != kontrol) printf("UYARI: rota maliyetleri farkli!\n");
+    }
+    yolOnbellegi.kapat();
+}
+
+// Rastgele rotalar bir kez bulunur, sonra yalnizca hat etiketleme olculur: eski dogrusal kenar
+// arama + liste taramasi, hash kenar arama + liste taramasi, hash + kenar hat kumeleri
+void benchEtiket(int tekrar) {
+    int V = durakSayisi;
+    int sorgu = 2000;
+    Rastgele rng(9);
+    AramaTamponu t;
+    VecArr<int> rotaOff, rotalar;
+    rotaOff.pushLast(0);
+    int enUzun = 1, adimSayisi = 0;
+    for (int i = 0; i < sorgu; ++i) {
+        int n = rotaBul(rng.aralik(0, V - 1), rng.aralik(0, V - 1), t);
+        for (int k = 0; k < n; ++k) rotalar.pushLast(t.path[k]);
+        rotaOff.pushLast(rotalar.size());
+        if (n > enUzun) enUzun = n;
+        if (n > 1) adimSayisi += n - 1;
+    }
+    int* etiket = (int*) std::malloc(sizeof(int) * enUzun);
+    int* beklenen = (int*) std::malloc(sizeof(int) * (rotalar.size() + 1));
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    kenarHatlari.kur(globalGraph, KENAR_KUME_SINIRI);
+    double kurMs = gecenMs(t0, std::chrono::steady_clock::now());
+    printf("\n--- Rota Etiketleme (%d rota, %d adim, %d hat, %d kenar; kume %d kelime/kenar, kurulum %.2f ms) ---\n",
+           sorgu, adimSayisi, hatSayisi, globalGraph.edgeCount(), kenarHatlari.kelime(), kurMs);
+    printf("%-22s %10s %12s\n", "yontem", "ms", "ns/adim");
+    long long adim = (long long) adimSayisi * tekrar;
+    if (adim < 1) adim = 1;
+
+    t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < tekrar; ++r)
+        for (int i = 0; i < sorgu; ++i) {
+            int n = rotaOff[i + 1] - rotaOff[i];
+            rotaEtiketleLineer(rotalar.ptr() + rotaOff[i], n, beklenen + rotaOff[i]);
+        }
+    double ms = gecenMs(t0, std::chrono::steady_clock::now());
+    printf("%-22s %10.2f %12.1f\n", "dogrusal (eski)", ms, ms * 1e6 / adim);
+
+    for (int k = 0; k < 2; ++k) {
+        if (k == 0) kenarHatlari.kapat(); else kenarHatlari.kur(globalGraph, KENAR_KUME_SINIRI);
+        bool ayni = true;
+        t0 = std::chrono::steady_clock::now();
+        for (int r = 0; r < tekrar; ++r)
+            for (int i = 0; i < sorgu; ++i) {
+                int n = rotaOff[i + 1] - rotaOff[i];
+                rotaEtiketle(rotalar.ptr() + rotaOff[i], n, etiket);
+                if (r == 0) for (int j = 0; j + 1 < n; ++j) if (etiket[j] != beklenen[rotaOff[i] + j]) ayni = false;
+            }
+        ms = gecenMs(t0, std::chrono::steady_clock::now());
+        printf("%-22s %10.2f %12.1f\n", k == 0 ? "hash + hat listesi" : "hash + hat kumesi", ms, ms * 1e6 / adim);
+        if (!ayni) printf("UYARI: etiketler farkli!\n");
+    }
+    std::free(etiket); std::free(beklenen);
+}
+
+static int doubleKarsilastir(const void* a, const void* b) {
+    double x = *(const double*) a, y = *(const double*) b;
+    return (x > y) - (x < y);
+}
+
+// Sorgu iscileri surekli PLAN cevaplarken ana is parcacigi guncelleme komutlarini sunucu yolundan
+// (yazma kilidi dahil) gonderir. Her guncelleme turu geri alinir, ag olcum boyunca ayni kalir.
+// Kilit bekleme dahil gecikme yuzdelikleri ve guncellemeli/guncellemesiz sorgu verimi yazilir
+void benchGuncelleme(int tekrar) {
+    int V = durakSayisi;
+    int isci = (int) std::thread::hardware_concurrency();
+    if (isci < 2) isci = 2;
+    Rastgele rng(11);
+    std::atomic<bool> dur(false);
+    std::atomic<long long> sorgular(0);
+    auto sorguIscisi = [&](int tohum) {
+        AramaTamponu t;
+        Rastgele r(tohum);
+        char istek[64];
+        while (!dur.load()) {
+            std::snprintf(istek, sizeof(istek), "PLAN %d %d", r.aralik(1, V), r.aralik(1, V));
+            char* buf = nullptr; size_t n = 0;
+            FILE* out = open_memstream(&buf, &n);
+            sorguCevapla(out, istek, t);
+            std::fclose(out);
+            std::free(buf);
+            sorgular++;
+        }
+    };
+    int yeniHat = 1;                 // olcum hatti: mevcut en buyuk numaranin bir fazlasi
+    for (int h = 0; h < hatSayisi; ++h) if (hatNoArr[h] >= yeniHat) yeniHat = hatNoArr[h] + 1;
+    const char* turAdi[] = { "KAPAT+AC", "MESAFE x2", "HATEKLE+SIL" };
+    VecArr<double> gecikme[3];
+    AramaTamponu bosTampon;
+    auto gonder = [&](const char* komut) {
+        char istek[4096];
+        std::snprintf(istek, sizeof(istek), "%s", komut);
+        char* buf = nullptr; size_t n = 0;
+        FILE* out = open_memstream(&buf, &n);
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        sorguCevapla(out, istek, bosTampon);
+        double ms = gecenMs(t0, std::chrono::steady_clock::now());
+        std::fclose(out);
+        std::free(buf);
+        return ms;
+    };
+    // MESAFE u v iki yondeki tum paralel kenarlari tek agirliga kurar, eksik yonu ekler. Geri alma
+    // agi ancak iki yon de varsa ve hepsi ayni agirliktaysa aynen birakir; yalnizca oyle ciftler secilir
+    auto geriAlinabilir = [](int u, int v, int w) {
+        bool ileri = false, geri = false;
+        for (int e = globalGraph.edgeBegin(u); e < globalGraph.edgeEnd(u); ++e)
+            if (globalGraph.edgeDest(e) == v) { if (globalGraph.edgeWeight(e) != w) return false; ileri = true; }
+        for (int e = globalGraph.edgeBegin(v); e < globalGraph.edgeEnd(v); ++e)
+            if (globalGraph.edgeDest(e) == u) { if (globalGraph.edgeWeight(e) != w) return false; geri = true; }
+        return ileri && geri;
+    };
+    auto guncellemeTurlari = [&]() {
+        char komut[4096];
+        for (int r = 0; r < tekrar; ++r) {
+            int d = rng.aralik(1, V);
+            std::snprintf(komut, sizeof(komut), "KAPAT %d", d);
+            double ms = gonder(komut);
+            std::snprintf(komut, sizeof(komut), "AC %d", d);
+            gecikme[0].pushLast(ms + gonder(komut));
+
+            int u = -1, v = -1, w = 0;
+            for (int deneme = 0; deneme < 64 && u == -1; ++deneme) {
+                int x = rng.aralik(0, V - 1);
+                if (globalGraph.edgeBegin(x) == globalGraph.edgeEnd(x)) continue;
+                int e = globalGraph.edgeBegin(x);
+                if (geriAlinabilir(x, globalGraph.edgeDest(e), globalGraph.edgeWeight(e))) {
+                    u = x; v = globalGraph.edgeDest(e); w = globalGraph.edgeWeight(e);
                 }
             }
-            printf("%d. %s (%d) [Hat: ", i+1, durakNameArr[u+1], u+1);
-            if (foundLine != -1) printf("%d", foundLine); else printf("Yok");
-            printf("]");
-            if (foundLine != prevLine && prevLine != -1) { printf(" <<< Aktarma!"); }
-            printf("\n");
-            prevLine = foundLine;
+            if (u != -1) {
+                std::snprintf(komut, sizeof(komut), "MESAFE %d %d %d", u + 1, v + 1, w + 5);
+                ms = gonder(komut);
+                std::snprintf(komut, sizeof(komut), "MESAFE %d %d %d", u + 1, v + 1, w);
+                gecikme[1].pushLast(ms + gonder(komut));
+            }
+
+            if (hatSayisi == 0) continue;
+            int h = rng.aralik(0, hatSayisi - 1);
+            int n = std::snprintf(komut, sizeof(komut), "HATEKLE %d ", yeniHat);
+            for (int i = 0; i < hatDuraklari[h].size() && n < (int) sizeof(komut) - 16; ++i)
+                n += std::snprintf(komut + n, sizeof(komut) - n, i ? ",%d" : "%d", hatDuraklari[h][i]);
+            std::snprintf(komut + n, sizeof(komut) - n, " Olcum");
+            ms = gonder(komut);
+            std::snprintf(komut, sizeof(komut), "HATSIL %d", yeniHat);
+            gecikme[2].pushLast(ms + gonder(komut));
         }
-        printf("%d. %s (%d) [Hat: ", pathLen, durakNameArr[path[pathLen-1]+1], path[pathLen-1]+1);
-        if (prevLine != -1) printf("%d", prevLine); else printf("Yok");
-        printf("]\n");
+    };
+    // guncelle false ise ms boyunca yalnizca sorgu, true ise guncelleme turlari bitene kadar
+    auto verimOlc = [&](double ms, bool guncelle) {
+        dur = false; sorgular = 0;
+        VecArr<std::thread*> isciler;
+        for (int i = 0; i < isci; ++i) isciler.pushLast(new std::thread(sorguIscisi, 100 + i));
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        if (guncelle) guncellemeTurlari();
+        while (gecenMs(t0, std::chrono::steady_clock::now()) < ms) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        dur = true;
+        for (int i = 0; i < isciler.size(); ++i) { isciler[i]->join(); delete isciler[i]; }
+        return sorgular.load() / (gecenMs(t0, std::chrono::steady_clock::now()) / 1000.0);
+    };
+
+    printf("\n--- Canli Guncelleme (%d sorgu iscisi, %d tur, %d durak, %d hat) ---\n", isci, tekrar, V, hatSayisi);
+    double sakinVerim = verimOlc(200, false);
+    double yukluVerim = verimOlc(0, true);
+
+    printf("%-14s %10s %10s %10s %10s\n", "guncelleme", "p50 ms", "p90 ms", "p99 ms", "en cok ms");
+    for (int k = 0; k < 3; ++k) {
+        VecArr<double>& g = gecikme[k];
+        if (g.size() == 0) continue;
+        std::qsort(g.ptr(), g.size(), sizeof(double), doubleKarsilastir);
+        int n = g.size();
+        printf("%-14s %10.3f %10.3f %10.3f %10.3f\n", turAdi[k], g[n / 2], g[n * 9 / 10], g[n * 99 / 100], g[n - 1]);
+    }
+    printf("Sorgu verimi: guncellemesiz %.0f istek/sn, guncellemeler sirasinda %.0f istek/sn\n", sakinVerim, yukluVerim);
+}
+
+// Tarifeli yolculuk planlama gecikmesi. --tarife verilmediyse her hatta 05:00-23:00 arasi 5-20 dk
+// aralikli sentetik bir tarife kurulur; rastgele cift ve kalkis saatleri icin yuzdelikler yazilir
+void benchSefer(int tekrar) {
+    int V = durakSayisi;
+    if (!tarife.hazir()) {
+        Rastgele r(5);
+        for (int h = 0; h < hatSayisi; ++h) tarife.satirEkle(hatNoArr[h], 300 + r.aralik(0, 19), 1380, r.aralik(5, 20));
+        tarife.kur(globalGraph);
+    }
+    int sorgu = tekrar * 50;
+    Rastgele rng(17);
+    SeferTamponu t;
+    SeferSonucu sonuc[SEFER_TUR_SINIRI + 1];
+    VecArr<double> g;
+    long long yolculuk = 0; int bulunan = 0;
+    printf("\n--- Tarifeli Yolculuk (RAPTOR, V=%d, %d rota, %d sefer, %d sorgu) ---\n",
+           V, tarife.rotaSayisi(), tarife.seferSayisi(), sorgu);
+    for (int i = 0; i < sorgu; ++i) {
+        int b = rng.aralik(0, V - 1), e = rng.aralik(0, V - 1), kalkis = rng.aralik(300, 1320);
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        int n = tarife.planla(b, e, kalkis, SEFER_TUR_SINIRI, t, sonuc);
+        g.pushLast(gecenMs(t0, std::chrono::steady_clock::now()));
+        yolculuk += n; if (n) bulunan++;
+    }
+    std::qsort(g.ptr(), g.size(), sizeof(double), doubleKarsilastir);
+    int n = g.size();
+    double toplam = 0;
+    for (int i = 0; i < n; ++i) toplam += g[i];
+    printf("%10s %10s %10s %10s %10s\n", "ort ms", "p50 ms", "p90 ms", "p99 ms", "en cok ms");
+    printf("%10.3f %10.3f %10.3f %10.3f %10.3f\n", toplam / n, g[n / 2], g[n * 9 / 10], g[n * 99 / 100], g[n - 1]);
+    printf("Yolculuk bulunan sorgu: %d/%d, sorgu basina ort. %.2f Pareto yolculuk\n", bulunan, sorgu,
+           bulunan ? (double) yolculuk / bulunan : 0.0);
+}
+
+// Daraltma hiyerarsisi: kurulum suresi ve kisayol sayisi, ardindan ayni rastgele ciftlerde cift
+// yonlu dijkstra ile hiyerarsi sorgusu (yerlesen dugum, sure). Rotalarin maliyeti ciftler tek tek karsilastirilir
+void benchHiyerarsi(int tekrar) {
+    int V = durakSayisi;
+    int sorgu = tekrar * 50;
+    std::chrono::steady_clock::time_point k0 = std::chrono::steady_clock::now();
+    int kisayol = hiyerarsi.kur(globalGraph);
+    double kurMs = gecenMs(k0, std::chrono::steady_clock::now());
+    Rastgele rng(11);
+    int* ciftler = (int*) std::malloc(sizeof(int) * 2 * sorgu);
+    for (int i = 0; i < 2 * sorgu; ++i) ciftler[i] = rng.aralik(0, V - 1);
+    long long* maliyet = (long long*) std::malloc(sizeof(long long) * sorgu);
+    AramaTamponu t;
+    long long yerlesenCift = 0, yerlesenHiy = 0;
+    int farkli = 0;
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < sorgu; ++i) {
+        int yerlesen = 0;
+        int n = globalGraph.dijkstraCiftYonlu(ciftler[2*i], ciftler[2*i+1], t.dist, t.parent, t.distB, t.parentB, t.path, yerlesen);
+        maliyet[i] = rotaMaliyeti(t.path, n);
+        yerlesenCift += yerlesen;
+    }
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    double hiyMs = 0;
+    for (int i = 0; i < sorgu; ++i) {
+        int yerlesen = 0;
+        std::chrono::steady_clock::time_point s0 = std::chrono::steady_clock::now();
+        int n = hiyerarsi.rota(ciftler[2*i], ciftler[2*i+1], t.hiyerarsiT, t.path, yerlesen);
+        hiyMs += gecenMs(s0, std::chrono::steady_clock::now());
+        if (rotaMaliyeti(t.path, n) != maliyet[i]) farkli++;
+        yerlesenHiy += yerlesen;
+    }
+    double ciftMs = gecenMs(t0, t1);
+
+    printf("\n--- Daraltma Hiyerarsisi (V=%d, E=%d, %d sorgu) ---\n", V, globalGraph.edgeCount(), sorgu);
+    printf("Kurulum: %.2f ms, %d kisayol, %d yukari kenar\n", kurMs, kisayol, hiyerarsi.yukariKenarSayisi());
+    printf("Cift yonlu    : %10.2f ms  %10.0f sorgu/sn  ort. yerlesen %10.1f\n", ciftMs, ciftMs > 0 ? sorgu / (ciftMs / 1000.0) : 0.0, (double) yerlesenCift / sorgu);
+    printf("Hiyerarsi     : %10.2f ms  %10.0f sorgu/sn  ort. yerlesen %10.1f  (rota acma dahil)\n", hiyMs, hiyMs > 0 ? sorgu / (hiyMs / 1000.0) : 0.0, (double) yerlesenHiy / sorgu);
+    printf("Hizlanma: %.1fx, sorgu basina %.3f ms\n", hiyMs > 0 ? ciftMs / hiyMs : 0.0, hiyMs / sorgu);
+    if (farkli) printf("UYARI: %d sorguda rota maliyeti farkli!\n", farkli);
+    std::free(ciftler); std::free(maliyet);
+    hiyerarsi.temizle();
+}
+
+// Yardimci: "--ad" bayragini argv'den cikarir, varsa true
+static bool bayrakAl(int& argc, char** argv, const char* ad) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], ad) != 0) continue;
+        for (int j = i; j + 1 < argc; ++j) argv[j] = argv[j + 1];
+        argc -= 1;
+        return true;
+    }
+    return false;
+}
 
-        free(dist); free(parent); break;
+// Yardimci: "--ad deger" secenegini argv'den cikarip degerini doner, yoksa nullptr
+static const char* secenekAl(int& argc, char** argv, const char* ad) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], ad) != 0) continue;
+        const char* deger = argv[i + 1];
+        for (int j = i; j + 2 < argc; ++j) argv[j] = argv[j + 2];
+        argc -= 2;
+        return deger;
     }
-    if (!bulundu) printf("Yolcu bulunamadi\n");
-    fclose(fp);
+    return nullptr;
 }
 
+// ANA MENU (ULASIM_MAIN_YOK tanimliysa derlenmez; ulasim_bench.cpp bu dosyayi boyle icerir)
+#ifndef ULASIM_MAIN_YOK
+static void olcumRaporuCikista() { olcumRaporuYaz(stderr); }
+
+int main(int argc, char** argv) {
+
+    // Genel secenekler: --tablo <dosya>  on hesaplanmis en kisa yol tablosunu kullan
+    const char* tabloF = secenekAl(argc, argv, "--tablo");
+    //                   --aktarma-cezasi <n>  rotalari mesafe + n * aktarma ile sec
+    const char* cezaF = secenekAl(argc, argv, "--aktarma-cezasi");
+    if (cezaF) aktarmaCezasi = std::atoi(cezaF);
+    //                   --hiyerarsi <dosya>  --daralt ile kurulmus daraltma hiyerarsisiyle rota bul
+    const char* hiyerarsiF = secenekAl(argc, argv, "--hiyerarsi");
+    //                   --onbellek <MB>  en kisa yol agaclarini bu bellek sinirinda sakla
+    const char* onbellekF = secenekAl(argc, argv, "--onbellek");
+    //                   --arenasiz  dugum ve kenarlari arena yerine tek tek ayir
+    if (bayrakAl(argc, argv, "--arenasiz")) arenaAcik = false;
+    //                   --ag <dosya>  metin dosyalari yerine --derle ile yazilmis anlik goruntuden ac
+    const char* agF = secenekAl(argc, argv, "--ag");
+    //                   --kenar-listesi  mesafe dosyasi (basliksiz da olsa) u,v,mesafe kenar listesidir
+    if (bayrakAl(argc, argv, "--kenar-listesi")) kenarListesiZorla = true;
+    //                   --tarife <dosya>  hat kalkis tarifesi (SEFER sorgulari icin)
+    const char* tarifeF = secenekAl(argc, argv, "--tarife");
+    //                   --aktarma-suresi <dk>  tarifeli yolculukta araclar arasi en az aktarma suresi
+    const char* aktSureF = secenekAl(argc, argv, "--aktarma-suresi");
+    if (aktSureF) tarife.aktarmaSuresi = std::atoi(aktSureF);
+    //                   --istatistik  cikista olcum raporunu stderr'e yaz (-DULASIM_OLCUM derlemesi)
+    if (bayrakAl(argc, argv, "--istatistik")) std::atexit(olcumRaporuCikista);
+
+    //                   --yukleme-iscisi <n>  mesafe dosyasini n parcada paralel ayristir (varsayilan cekirdek sayisi)
+    const char* yukIsciF = secenekAl(argc, argv, "--yukleme-iscisi");
+    yuklemeIscisi = yukIsciF ? std::atoi(yukIsciF) : (int) std::thread::hardware_concurrency();
+
+    // Bicim cevirici: ./ulasim --kenarla <matris> <cikti>
+    if (argc >= 4 && std::strcmp(argv[1], "--kenarla") == 0)
+        return matrisiKenarListesineCevir(argv[2], argv[3]) ? 0 : 1;
 
-// ANA MENU 
-int main() {
+    // Sentetik ag: ./ulasim --uret <durak> <hat> [yolcu] [tohum] [klasor]
+    if (argc >= 4 && std::strcmp(argv[1], "--uret") == 0) {
+        int yolcuN = (argc >= 5) ? std::atoi(argv[4]) : 1000;
+        unsigned long long tohum = (argc >= 6) ? std::strtoull(argv[5], nullptr, 10) : 1;
+        const char* klasor = (argc >= 7) ? argv[6] : ".";
+        sentetikAgUret(std::atoi(argv[2]), std::atoi(argv[3]), yolcuN, tohum, klasor);
+        return 0;
+    }
+
+    std::chrono::steady_clock::time_point yukBas = std::chrono::steady_clock::now();
+    if (agF) { if (!agAnlikYukle(agF)) return 1; }
+    else grafOlustur("durak_listesi.txt", "hatlar.txt", "durak_mesafeleri.txt", globalGraph);
+    double yuklemeMs = gecenMs(yukBas, std::chrono::steady_clock::now());
+
+    // Derleme: ./ulasim --derle <dosya>
+    if (argc >= 3 && std::strcmp(argv[1], "--derle") == 0) {
+        if (!agAnlikKaydet(argv[2])) return 1;
+        printf("Ag %s dosyasina yazildi (%d durak, %d hat, %d kenar; ayristirma %.2f ms)\n",
+               argv[2], durakSayisi, hatSayisi, globalGraph.edgeCount(), yuklemeMs);
+        return 0;
+    }
+
+    // On hesaplama: ./ulasim --onhesap <dosya> [isci]
+    if (argc >= 3 && std::strcmp(argv[1], "--onhesap") == 0) {
+        int isci = (argc >= 4) ? std::atoi(argv[3]) : (int) std::thread::hardware_concurrency();
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        mesafeTablosu.hesapla(globalGraph, isci);
+        double ms = gecenMs(t0, std::chrono::steady_clock::now());
+        if (!mesafeTablosu.kaydet(argv[2], globalGraph)) return 1;
+        printf("Tablo %s dosyasina yazildi (V=%d, %.2f ms)\n", argv[2], durakSayisi, ms);
+        return 0;
+    }
+    // Daraltma hiyerarsisi: ./ulasim --daralt <dosya>
+    if (argc >= 3 && std::strcmp(argv[1], "--daralt") == 0) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        int kisayol = hiyerarsi.kur(globalGraph);
+        double ms = gecenMs(t0, std::chrono::steady_clock::now());
+        if (!hiyerarsi.kaydet(argv[2], globalGraph)) return 1;
+        printf("Hiyerarsi %s dosyasina yazildi (V=%d, %d kisayol, %d yukari kenar, %.2f ms)\n",
+               argv[2], durakSayisi, kisayol, hiyerarsi.yukariKenarSayisi(), ms);
+        return 0;
+    }
+    if (tabloF && !mesafeTablosu.yukle(tabloF, globalGraph)) return 1;
+    if (hiyerarsiF && !hiyerarsi.yukle(hiyerarsiF, globalGraph)) return 1;
+    if (aktarmaCezasi >= 0) aktarmaMotoru.kur(globalGraph);
+    kenarHatlari.kur(globalGraph, KENAR_KUME_SINIRI);
+    if (tarifeF) {
+        if (!tarife.yukle(tarifeF)) return 1;
+        tarife.kur(globalGraph);
+    }
+    if (onbellekF) yolOnbellegi.kur(durakSayisi, aktarmaMotoru.hazir() ? aktarmaMotoru.durumSayisi() + 1 : durakSayisi,
+                                    (long long) (std::atof(onbellekF) * 1024 * 1024));
 
-    grafOlustur("durak_listesi.txt", "hatlar.txt", "durak_mesafeleri.txt", globalGraph);
+    // Toplu mod: ./ulasim --toplu [yolcu_dosyasi] [cikti_dosyasi]
+    if (argc >= 2 && std::strcmp(argv[1], "--toplu") == 0) {
+        const char* yolcuF = (argc >= 3) ? argv[2] : "yolcu_listesi.txt";
+        const char* ciktiF = (argc >= 4) ? argv[3] : "toplu_plan.txt";
+        yolcuTopluPlanla(yolcuF, ciktiF);
+        return 0;
+    }
+
+    // Tarifeli yolculuk: ./ulasim --tarife <dosya> --sefer <basID> <bitID> <SS:DD>
+    if (argc >= 5 && std::strcmp(argv[1], "--sefer") == 0) {
+        int kalkis = saatAyristir(argv[4], std::strlen(argv[4]));
+        int basID = std::atoi(argv[2]), bitID = std::atoi(argv[3]);
+        if (!tarife.hazir()) { printf("Tarife yuklu degil (--tarife <dosya>)\n"); return 1; }
+        if (kalkis < 0 || basID < 1 || basID > durakSayisi || bitID < 1 || bitID > durakSayisi) {
+            printf("Kullanim: --sefer <basID> <bitID> <SS:DD>\n"); return 1;
+        }
+        SeferTamponu t;
+        seferYazdir(stdout, basID, bitID, kalkis, t);
+        return 0;
+    }
+
+    // Sunucu modu: ./ulasim --sunucu [isci] [soket_yolu]  (soket verilmezse stdin/stdout)
+    if (argc >= 2 && std::strcmp(argv[1], "--sunucu") == 0) {
+        int isci = (argc >= 3) ? std::atoi(argv[2]) : (int) std::thread::hardware_concurrency();
+        sunucuCalistir((argc >= 4) ? argv[3] : nullptr, isci);
+        return 0;
+    }
+
+    // Olcum modu: ./ulasim --bench csr [tekrar]
+    if (argc >= 3 && std::strcmp(argv[1], "--bench") == 0) {
+        int tekrar = (argc >= 4) ? std::atoi(argv[3]) : 20;
+        if (tekrar < 1) tekrar = 1;
+        printf("Yukleme (%s): %.2f ms\n", agF ? "anlik goruntu" : "grafOlustur", yuklemeMs);
+        if (std::strcmp(argv[2], "csr") == 0) benchCSR(tekrar);
+        else if (std::strcmp(argv[2], "isim") == 0) benchIsim(tekrar);
+        else if (std::strcmp(argv[2], "sunucu") == 0) benchSunucu(tekrar);
+        else if (std::strcmp(argv[2], "tablo") == 0) benchTablo(tekrar);
+        else if (std::strcmp(argv[2], "p2p") == 0) benchNoktaNokta(tekrar);
+        else if (std::strcmp(argv[2], "heap") == 0) benchHeap(tekrar);
+        else if (std::strcmp(argv[2], "vecarr") == 0) benchVecArr(tekrar);
+        else if (std::strcmp(argv[2], "yukleme") == 0) benchYukleme(yuklemeMs);
+        else if (std::strcmp(argv[2], "indeks") == 0) benchIndeks(tekrar);
+        else if (std::strcmp(argv[2], "csv") == 0) benchCsv(tekrar);
+        else if (std::strcmp(argv[2], "matris") == 0) benchMatris(tekrar);
+        else if (std::strcmp(argv[2], "paralel") == 0) benchParalelYukleme(tekrar);
+        else if (std::strcmp(argv[2], "yolcu") == 0) benchYolcu(tekrar);
+        else if (std::strcmp(argv[2], "onbellek") == 0) benchOnbellek(tekrar);
+        else if (std::strcmp(argv[2], "etiket") == 0) benchEtiket(tekrar);
+        else if (std::strcmp(argv[2], "guncelleme") == 0) benchGuncelleme(tekrar);
+        else if (std::strcmp(argv[2], "sefer") == 0) benchSefer(tekrar);
+        else if (std::strcmp(argv[2], "hiyerarsi") == 0) benchHiyerarsi(tekrar);
+        else printf("Bilinmeyen olcum: %s\n", argv[2]);
+        return 0;
+    }
 
     while (true) {
         printf("\n=== Ulasim Menu ===\n");
@@ -642,7 +5545,7 @@ int main() {
         else if (secim == 3) {
             printf("Durak ID giriniz: ");
             int durakID; scanf("%d", &durakID);
-            if (durakID < 1 || durakID > MAX_DURAK) { printf("Gecersiz durak ID.\n"); }
+            if (durakID < 1 || durakID > durakSayisi) { printf("Gecersiz durak ID.\n"); }
             else { durakAra(durakID); }
         }
         else if (secim == 4) {
@@ -656,3 +5559,4 @@ int main() {
     }
     return 0;
 }
+#endif
@@ -0,0 +1,232 @@
+// Olcum surucusu: tohumlu sentetik bir sehir uretir, yukleme / arama / isim ve indeks sorgusu /
+// yolcu planlama / daraltma hiyerarsisi yollarini tek tek zamanlar ve yuzdelikleri JSON satirlari
+// olarak dosyaya ekler.
+// Her calisma ayni dosyaya eklendigi icin gerilemeler zaman icinde izlenebilir.
+//
+//     g++ -std=c++11 -O2 -DNDEBUG -pthread ulasim_bench.cpp -o ulasim_bench
+//     ./ulasim_bench [--durak n] [--hat n] [--yolcu n] [--tohum n] [--tekrar n]
+//                    [--klasor dizin] [--cikti dosya.jsonl] [--hazir] [--kenar-listesi]
+
+#define ULASIM_MAIN_YOK
+#include "ulasim.cpp"
+
+#include <ctime>
+
+// Olculen donguler sonucu buraya toplar; derleyici hesaplamayi atamasin
+static volatile long long olcumKontrol = 0;
+
+struct OlcumAyari {
+    int durak, hat, yolcu, tekrar;
+    unsigned long long tohum;
+    const char* klasor;
+    FILE* cikti;
+    long long zaman;
+};
+
+// Ornekleri siralar, ozet satirini ekrana ve JSON satirini cikti dosyasina yazar
+static void yuzdelikYaz(const OlcumAyari& a, const char* olcum, const char* birim, VecArr<double>& ornek) {
+    int n = ornek.size();
+    if (n == 0) return;
+    std::qsort(ornek.ptr(), n, sizeof(double), doubleKarsilastir);
+    double toplam = 0;
+    for (int i = 0; i < n; ++i) toplam += ornek[i];
+    double p50 = ornek[n / 2], p90 = ornek[n * 9 / 10], p99 = ornek[n * 99 / 100];
+    printf("%-22s %6s %8d %12.3f %12.3f %12.3f %12.3f %12.3f\n", olcum, birim, n, toplam / n, p50, p90, p99, ornek[n - 1]);
+    std::fprintf(a.cikti, "{\"zaman\":%lld,\"olcum\":\"%s\",\"birim\":\"%s\",\"durak\":%d,\"hat\":%d,\"yolcu\":%d,"
+                 "\"tohum\":%llu,\"ornek\":%d,\"ort\":%.4f,\"p50\":%.4f,\"p90\":%.4f,\"p99\":%.4f,\"en_cok\":%.4f}\n",
+                 a.zaman, olcum, birim, a.durak, a.hat, a.yolcu, a.tohum, n, toplam / n, p50, p90, p99, ornek[n - 1]);
+}
+
+// grafOlustur her tekrarda ayri bir alt surecte, global tablolar bosaltilarak calisir
+static void yuklemeOlc(const OlcumAyari& a, const char* durakF, const char* hatF, const char* mesafeF) {
+    VecArr<double> ornek;
+    int tekrar = a.tekrar < 5 ? a.tekrar : 5;
+    for (int r = 0; r < tekrar; ++r) {
+        int boru[2];
+        if (::pipe(boru) != 0) { std::perror("pipe"); return; }
+        std::fflush(stdout);
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            ::close(boru[0]);
+            durakIsimleri.temizle();
+            hatNoArr.clear(); hatNameArr.clear(); hatDuraklari.clear(); hatDurakAdlari.clear();
+            std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+            grafOlustur(durakF, hatF, mesafeF, globalGraph);
+            double ms = gecenMs(t0, std::chrono::steady_clock::now());
+            ssize_t yazilan = ::write(boru[1], &ms, sizeof(ms));
+            ::_exit(yazilan == (ssize_t) sizeof(ms) ? 0 : 1);
+        }
+        ::close(boru[1]);
+        double ms = 0;
+        bool ok = pid > 0 && ::read(boru[0], &ms, sizeof(ms)) == (ssize_t) sizeof(ms);
+        ::close(boru[0]);
+        if (pid > 0) ::waitpid(pid, nullptr, 0);
+        if (ok) ornek.pushLast(ms);
+    }
+    yuzdelikYaz(a, "grafOlustur", "ms", ornek);
+}
+
+// Tek kaynakli tam dijkstra, rastgele kaynaklar
+static void dijkstraOlc(const OlcumAyari& a) {
+    int V = durakSayisi;
+    int* dist = (int*) std::malloc(sizeof(int) * V);
+    int* parent = (int*) std::malloc(sizeof(int) * V);
+    Rastgele rng(a.tohum + 1);
+    VecArr<double> ornek;
+    long long kontrol = 0;
+    for (int i = 0; i < a.tekrar * 10; ++i) {
+        int src = rng.aralik(0, V - 1);
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        globalGraph.dijkstra(src, dist, parent);
+        ornek.pushLast(gecenMs(t0, std::chrono::steady_clock::now()) * 1e3);
+        kontrol += dist[V - 1];
+    }
+    std::free(dist); std::free(parent);
+    olcumKontrol = olcumKontrol + kontrol;
+    yuzdelikYaz(a, "Graph::dijkstra", "us", ornek);
+}
+
+// Durak -> hat sorgusu: yukleyicinin eskiden kurdugu BST ile duz ofset indeksi. Tek arama
+// olculemeyecek kadar kisa oldugundan her ornek 1024 aramanin ortalamasidir (ns/arama)
+static void indeksOlc(const OlcumAyari& a) {
+    DurakHatBST bst;
+    for (int h = 0; h < hatSayisi; ++h)
+        for (int i = 0; i < hatDuraklari[h].size(); ++i) bst.insert(hatDuraklari[h][i], hatNoArr[h]);
+    const int grup = 1024;
+    Rastgele rng(a.tohum + 2);
+    int* sorgu = (int*) std::malloc(sizeof(int) * grup);
+    VecArr<double> bstOrnek, idxOrnek;
+    long long kontrolBst = 0, kontrolIdx = 0;
+    for (int r = 0; r < a.tekrar * 10; ++r) {
+        for (int i = 0; i < grup; ++i) sorgu[i] = rng.aralik(1, durakSayisi);
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < grup; ++i) { BSTNode* node = bst.search(sorgu[i]); if (node) kontrolBst += node->hatList.head()->val; }
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        for (int i = 0; i < grup; ++i) if (durakHatIndeksi.hatSayisi(sorgu[i]) > 0) kontrolIdx += durakHatIndeksi.hatlar(sorgu[i])[0];
+        std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+        bstOrnek.pushLast(gecenMs(t0, t1) * 1e6 / grup);
+        idxOrnek.pushLast(gecenMs(t1, t2) * 1e6 / grup);
+    }
+    std::free(sorgu);
+    yuzdelikYaz(a, "DurakHatBST::search", "ns", bstOrnek);
+    yuzdelikYaz(a, "DurakHatIndeksi", "ns", idxOrnek);
+    if (kontrolBst != kontrolIdx) printf("UYARI: BST ve indeks farkli sonuc verdi!\n");
+}
+
+// Isimden ID: her ornek 1024 rastgele durak adinin ortalamasi (ns/arama)
+static void isimOlc(const OlcumAyari& a) {
+    const int grup = 1024;
+    Rastgele rng(a.tohum + 3);
+    const char** adlar = (const char**) std::malloc(sizeof(char*) * grup);
+    VecArr<double> ornek;
+    long long kontrol = 0;
+    for (int r = 0; r < a.tekrar * 10; ++r) {
+        for (int i = 0; i < grup; ++i) adlar[i] = durakAdi(rng.aralik(1, durakSayisi));
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < grup; ++i) kontrol += findDurakIDbyName(adlar[i]);
+        ornek.pushLast(gecenMs(t0, std::chrono::steady_clock::now()) * 1e6 / grup);
+    }
+    std::free(adlar);
+    olcumKontrol = olcumKontrol + kontrol;
+    yuzdelikYaz(a, "findDurakIDbyName", "ns", ornek);
+}
+
+// Menu 4'un tam yolu: yolcu deposundan arama, rota ve hat etiketli cikti. Cikti /dev/null'a gider
+static void yolcuPlanlaOlc(const OlcumAyari& a, const char* yolcuF) {
+    Rastgele rng(a.tohum + 4);
+    int bosCikis = ::open("/dev/null", O_WRONLY);
+    std::fflush(stdout);
+    int eskiCikis = ::dup(1);
+    ::dup2(bosCikis, 1);
+    yolcuPlanla(yolcuF, 1);                  // deponun ilk kurulumu olcume girmesin
+    std::fflush(stdout);
+    int yolcuN = yolcuDeposu.yolcuSayisi() > 0 ? yolcuDeposu.yolcuSayisi() : 1;
+    VecArr<double> ornek;
+    for (int i = 0; i < a.tekrar * 20; ++i) {
+        int id = rng.aralik(1, yolcuN);
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        yolcuPlanla(yolcuF, id);
+        std::fflush(stdout);
+        ornek.pushLast(gecenMs(t0, std::chrono::steady_clock::now()) * 1e3);
+    }
+    ::dup2(eskiCikis, 1);
+    ::close(eskiCikis); ::close(bosCikis);
+    yuzdelikYaz(a, "yolcuPlanla", "us", ornek);
+}
+
+// Daraltma hiyerarsisi: kurulum suresi (tek ornek) ve ayni rastgele ciftlerde cift yonlu
+// dijkstra ile hiyerarsi sorgusunun gecikme dagilimi. Maliyeti farkli rota kontrolde sayilir
+static void hiyerarsiOlc(const OlcumAyari& a) {
+    int V = durakSayisi;
+    VecArr<double> kurulum;
+    std::chrono::steady_clock::time_point k0 = std::chrono::steady_clock::now();
+    hiyerarsi.kur(globalGraph);
+    kurulum.pushLast(gecenMs(k0, std::chrono::steady_clock::now()));
+    Rastgele rng(a.tohum + 5);
+    AramaTamponu t;
+    VecArr<double> ciftOrnek, hiyOrnek;
+    long long kontrol = 0;
+    for (int i = 0; i < a.tekrar * 20; ++i) {
+        int bas = rng.aralik(0, V - 1), bit = rng.aralik(0, V - 1);
+        int yerlesen = 0;
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        int n = globalGraph.dijkstraCiftYonlu(bas, bit, t.dist, t.parent, t.distB, t.parentB, t.path, yerlesen);
+        ciftOrnek.pushLast(gecenMs(t0, std::chrono::steady_clock::now()) * 1e3);
+        long long maliyet = rotaMaliyeti(t.path, n);
+        t0 = std::chrono::steady_clock::now();
+        n = hiyerarsi.rota(bas, bit, t.hiyerarsiT, t.path, yerlesen);
+        hiyOrnek.pushLast(gecenMs(t0, std::chrono::steady_clock::now()) * 1e3);
+        if (rotaMaliyeti(t.path, n) != maliyet) kontrol++;
+    }
+    hiyerarsi.temizle();
+    olcumKontrol = olcumKontrol + kontrol;
+    if (kontrol) fprintf(stderr, "UYARI: %lld sorguda hiyerarsi rotasi farkli\n", kontrol);
+    yuzdelikYaz(a, "hiyerarsi.kur", "ms", kurulum);
+    yuzdelikYaz(a, "dijkstraCiftYonlu", "us", ciftOrnek);
+    yuzdelikYaz(a, "hiyerarsi.rota", "us", hiyOrnek);
+}
+
+int main(int argc, char** argv) {
+    OlcumAyari a;
+    const char* s;
+    a.durak = (s = secenekAl(argc, argv, "--durak")) ? std::atoi(s) : 2000;
+    a.hat = (s = secenekAl(argc, argv, "--hat")) ? std::atoi(s) : 200;
+    a.yolcu = (s = secenekAl(argc, argv, "--yolcu")) ? std::atoi(s) : 5000;
+    a.tohum = (s = secenekAl(argc, argv, "--tohum")) ? std::strtoull(s, nullptr, 10) : 1;
+    a.tekrar = (s = secenekAl(argc, argv, "--tekrar")) ? std::atoi(s) : 20;
+    a.klasor = (s = secenekAl(argc, argv, "--klasor")) ? s : "bench_sehir";
+    const char* ciktiF = (s = secenekAl(argc, argv, "--cikti")) ? s : "ulasim_bench.jsonl";
+    bool hazir = bayrakAl(argc, argv, "--hazir");       // klasordeki dosyalari yeniden uretme
+    if (bayrakAl(argc, argv, "--kenar-listesi")) kenarListesiZorla = true;
+    if (a.tekrar < 1) a.tekrar = 1;
+    a.zaman = (long long) std::time(nullptr);
+
+    if (!hazir) {
+        ::mkdir(a.klasor, 0755);
+        sentetikAgUret(a.durak, a.hat, a.yolcu, a.tohum, a.klasor);
+    }
+    char durakF[1024], hatF[1024], mesafeF[1024], yolcuF[1024];
+    yolBirlestir(durakF, sizeof(durakF), a.klasor, "durak_listesi.txt");
+    yolBirlestir(hatF, sizeof(hatF), a.klasor, "hatlar.txt");
+    yolBirlestir(mesafeF, sizeof(mesafeF), a.klasor, "durak_mesafeleri.txt");
+    yolBirlestir(yolcuF, sizeof(yolcuF), a.klasor, "yolcu_listesi.txt");
+
+    a.cikti = std::fopen(ciktiF, "a");
+    if (!a.cikti) { std::perror(ciktiF); return 1; }
+    printf("%-22s %6s %8s %12s %12s %12s %12s %12s\n", "olcum", "birim", "ornek", "ort", "p50", "p90", "p99", "en cok");
+    grafOlustur(durakF, hatF, mesafeF, globalGraph);
+    kenarHatlari.kur(globalGraph, KENAR_KUME_SINIRI);
+    if (hazir) {
+        a.durak = durakSayisi; a.hat = hatSayisi;
+        a.yolcu = yolcuDeposu.yenile(yolcuF) ? yolcuDeposu.yolcuSayisi() : 0;
+    }
+    yuklemeOlc(a, durakF, hatF, mesafeF);
+    dijkstraOlc(a);
+    indeksOlc(a);
+    isimOlc(a);
+    yolcuPlanlaOlc(a, yolcuF);
+    hiyerarsiOlc(a);
+    std::fclose(a.cikti);
+    printf("Sonuclar %s dosyasina eklendi\n", ciktiF);
+    return 0;
+}